@@ -7,10 +7,100 @@
 #include "Emu/RSX/RSXThread.h"
 #include "Emu/Memory/vm.h"
 
+#include "util/serialization.hpp"
 #include "xxhash.h"
 
+#include <zlib.h>
+
 namespace rsx
 {
+	static bool write_chunk(fs::file& file, const std::vector<u8>& data, u32 fifo_size)
+	{
+		if (data.size() > u32{umax})
+		{
+			rsx_log.error("Capture chunk is too large (0x%llx bytes)", data.size());
+			return false;
+		}
+
+		uLongf compressed_size = compressBound(static_cast<uLong>(data.size()));
+		std::vector<u8> compressed(compressed_size);
+
+		// Speed matters more than ratio here, the chunk is written while the game is running
+		if (const int res = compress2(compressed.data(), &compressed_size, data.data(), static_cast<uLong>(data.size()), Z_BEST_SPEED); res != Z_OK)
+		{
+			rsx_log.error("Failed to compress capture chunk (error %d)", res);
+			return false;
+		}
+
+		const frame_capture_chunk_header header
+		{
+			.compressed_size = static_cast<u32>(compressed_size),
+			.uncompressed_size = static_cast<u32>(data.size()),
+			.fifo_size = fifo_size,
+		};
+
+		return file.write(header).write(compressed.data(), compressed_size) == compressed_size;
+	}
+
+	bool frame_capture_writer::open(const std::string& path, frame_capture_data& capture)
+	{
+		m_path = path;
+		m_frame_count = 0;
+		m_file = std::make_unique<fs::pending_file>(path);
+
+		if (!m_file->file)
+		{
+			m_file.reset();
+			return false;
+		}
+
+		utils::serial ar;
+		ar(capture);
+
+		if (!write_chunk(m_file->file, ar.data, 0))
+		{
+			m_file.reset();
+			return false;
+		}
+
+		return true;
+	}
+
+	bool frame_capture_writer::write_frame(frame_capture_data& capture)
+	{
+		if (!m_file)
+		{
+			return false;
+		}
+
+		capture.discard_stored_entries();
+
+		utils::serial ar;
+		ar(capture.tile_map, capture.memory_map, capture.memory_data_map, capture.display_buffers_map, capture.replay_commands);
+
+		if (!write_chunk(m_file->file, ar.data, capture.get_fifo_size()))
+		{
+			m_file.reset();
+			return false;
+		}
+
+		capture.on_chunk_stored();
+		m_frame_count++;
+		return true;
+	}
+
+	bool frame_capture_writer::commit()
+	{
+		if (!m_file)
+		{
+			return false;
+		}
+
+		const bool result = m_file->commit(false);
+		m_file.reset();
+		return result;
+	}
+
 	namespace capture
 	{
 		void insert_mem_block_in_map(std::unordered_set<u64>& mem_changes, frame_capture_data::memory_block&& block, frame_capture_data::memory_block_data&& data)
@@ -21,7 +111,11 @@ namespace rsx
 				block.data_state = data_hash;
 
 				auto it = frame_capture.memory_data_map.find(data_hash);
-				if (it != frame_capture.memory_data_map.end())
+				if (frame_capture.stored_data.contains(data_hash))
+				{
+					// Already written to the capture file by a previous frame
+				}
+				else if (it != frame_capture.memory_data_map.end())
 				{
 					if (it->second.data != data.data)
 						// screw this
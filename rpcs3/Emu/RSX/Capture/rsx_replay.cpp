@@ -5,23 +5,290 @@
 #include "Emu/Cell/lv2/sys_rsx.h"
 #include "Emu/Cell/lv2/sys_memory.h"
 #include "Emu/RSX/RSXThread.h"
+#include "Utilities/StrUtil.h"
+#include "Utilities/date_time.h"
 
 #include "util/asm.hpp"
+#include "util/serialization.hpp"
+
+#include <zlib.h>
 
 namespace rsx
 {
-	be_t<u32> rsx_replay_thread::allocate_context()
+	namespace
+	{
+		// Per-frame results of a capture replay benchmark
+		struct replay_benchmark
+		{
+			struct frame_sample
+			{
+				u32 iteration;
+				u32 frame;
+				u64 wall_time; // Replay thread time from FIFO kick-off to presentation
+				frame_statistics_t stats;
+			};
+
+			std::vector<frame_sample> samples;
+
+			// Written by the RSX thread on every emulated flip
+			frame_statistics_t last_stats{};
+			atomic_t<u64> presented_frames = 0;
+
+			bool wait_for_present(u64 previous)
+			{
+				while (presented_frames <= previous)
+				{
+					if (Emu.IsStopped())
+					{
+						return false;
+					}
+
+					// Sleep until the RSX thread reports the flip, waking periodically to notice a stop request
+					thread_ctrl::wait_on(presented_frames, previous, 100'000);
+				}
+
+				return true;
+			}
+
+			void save(const std::string& capture_path, u32 warmup_iterations, u32 iterations) const
+			{
+				const auto draw_time = [](const frame_statistics_t& stats)
+				{
+					return stats.setup_time + stats.vertex_upload_time + stats.textures_upload_time + stats.draw_exec_time;
+				};
+
+				const auto percentile = [](const std::vector<u64>& sorted, u32 pct) -> u64
+				{
+					return sorted.empty() ? 0 : sorted[(sorted.size() - 1) * pct / 100];
+				};
+
+				std::vector<u64> frame_times;
+				u64 total_time = 0, total_draws = 0, total_draw_time = 0, total_uploads = 0, total_misses = 0, total_compiles = 0;
+				u64 total_zcull_stalls = 0, total_zcull_stall_time = 0, total_zcull_speculative = 0, total_zcull_misses = 0;
+
+				for (const auto& sample : samples)
+				{
+					frame_times.push_back(sample.wall_time);
+					total_time += sample.wall_time;
+					total_draws += sample.stats.draw_calls;
+					total_draw_time += draw_time(sample.stats);
+					total_uploads += sample.stats.texture_uploads;
+					total_misses += sample.stats.texture_upload_misses;
+					total_compiles += sample.stats.shader_compiles;
+					total_zcull_stalls += sample.stats.zcull_sync_stalls;
+					total_zcull_stall_time += sample.stats.zcull_sync_stall_time;
+					total_zcull_speculative += sample.stats.zcull_speculative_reports;
+					total_zcull_misses += sample.stats.zcull_speculation_misses;
+				}
+
+				std::sort(frame_times.begin(), frame_times.end());
+
+				const std::string capture_name = capture_path.substr(capture_path.find_last_of(fs::delim) + 1);
+				const std::string file_path = fs::get_config_dir() + "captures/" + capture_name + "_" + date_time::current_time_narrow() + "_benchmark.json";
+
+				std::string json = "{\n";
+				fmt::append(json, "\t\"capture\": \"%s\",\n", fmt::replace_all(fmt::replace_all(capture_name, "\\", "\\\\"), "\"", "\\\""));
+				fmt::append(json, "\t\"renderer\": \"%s\",\n", g_cfg.video.renderer.get());
+				fmt::append(json, "\t\"warmup_iterations\": %u,\n\t\"iterations\": %u,\n", warmup_iterations, iterations);
+				json += "\t\"summary\": {\n";
+				fmt::append(json, "\t\t\"frames\": %u,\n", samples.size());
+				fmt::append(json, "\t\t\"frame_time_us\": { \"avg\": %llu, \"min\": %llu, \"p50\": %llu, \"p95\": %llu, \"p99\": %llu, \"max\": %llu },\n",
+					samples.empty() ? 0 : total_time / samples.size(), percentile(frame_times, 0), percentile(frame_times, 50), percentile(frame_times, 95),
+					percentile(frame_times, 99), percentile(frame_times, 100));
+				fmt::append(json, "\t\t\"draw_calls\": %llu,\n\t\t\"draw_time_avg_us\": %.3f,\n", total_draws, total_draws ? static_cast<f64>(total_draw_time) / total_draws : 0.);
+				fmt::append(json, "\t\t\"texture_uploads\": %llu,\n\t\t\"texture_upload_misses\": %llu,\n\t\t\"texture_cache_hit_rate\": %.4f,\n",
+					total_uploads, total_misses, total_uploads ? 1. - static_cast<f64>(total_misses) / total_uploads : 1.);
+				fmt::append(json, "\t\t\"shader_compiles\": %llu,\n", total_compiles);
+				fmt::append(json, "\t\t\"zcull_sync_stalls\": %llu,\n\t\t\"zcull_sync_stall_us\": %llu,\n", total_zcull_stalls, total_zcull_stall_time);
+				fmt::append(json, "\t\t\"zcull_speculative_reports\": %llu,\n\t\t\"zcull_speculation_misses\": %llu\n\t},\n", total_zcull_speculative, total_zcull_misses);
+				json += "\t\"frames\": [\n";
+
+				for (usz i = 0; i < samples.size(); i++)
+				{
+					const auto& [iteration, frame, wall_time, stats] = samples[i];
+
+					fmt::append(json, "\t\t{ \"iteration\": %u, \"frame\": %u, \"wall_us\": %llu, \"draw_calls\": %u, \"draw_time_avg_us\": %.3f, "
+						"\"fifo_us\": %lld, \"setup_us\": %lld, \"vertex_upload_us\": %lld, \"texture_upload_us\": %lld, \"draw_exec_us\": %lld, \"flip_us\": %lld, \"gpu_us\": %lld, "
+						"\"texture_uploads\": %u, \"texture_upload_misses\": %u, \"shader_compiles\": %u, \"zcull_sync_stalls\": %u, \"zcull_sync_stall_us\": %lld, "
+						"\"zcull_speculative_reports\": %u, \"zcull_speculation_misses\": %u }%s\n",
+						iteration, frame, wall_time, stats.draw_calls, stats.draw_calls ? static_cast<f64>(draw_time(stats)) / stats.draw_calls : 0.,
+						stats.fifo_time, stats.setup_time, stats.vertex_upload_time, stats.textures_upload_time, stats.draw_exec_time, stats.flip_time, stats.gpu_time,
+						stats.texture_uploads, stats.texture_upload_misses, stats.shader_compiles, stats.zcull_sync_stalls, stats.zcull_sync_stall_time,
+						stats.zcull_speculative_reports, stats.zcull_speculation_misses, i + 1 < samples.size() ? "," : "");
+				}
+
+				json += "\t]\n}\n";
+
+				if (fs::pending_file file(file_path); file.file && (file.file.write(json), file.commit(false)))
+				{
+					rsx_log.success("Capture Replay: benchmark of %u frame(s) written to %s (avg %lluus, p99 %lluus)", samples.size(), file_path,
+						samples.empty() ? 0 : total_time / samples.size(), percentile(frame_times, 99));
+				}
+				else
+				{
+					rsx_log.error("Capture Replay: failed to write benchmark results to %s (%s)", file_path, fs::g_tls_error);
+				}
+			}
+		};
+	}
+
+	void frame_capture_data::discard_stored_entries()
+	{
+		std::erase_if(tile_map, [this](const auto& entry) { return stored_tiles.contains(entry.first); });
+		std::erase_if(memory_map, [this](const auto& entry) { return stored_blocks.contains(entry.first); });
+		std::erase_if(memory_data_map, [this](const auto& entry) { return stored_data.contains(entry.first); });
+		std::erase_if(display_buffers_map, [this](const auto& entry) { return stored_display_buffers.contains(entry.first); });
+	}
+
+	void frame_capture_data::on_chunk_stored()
+	{
+		for (const auto& entry : tile_map) stored_tiles.insert(entry.first);
+		for (const auto& entry : memory_map) stored_blocks.insert(entry.first);
+		for (const auto& entry : memory_data_map) stored_data.insert(entry.first);
+		for (const auto& entry : display_buffers_map) stored_display_buffers.insert(entry.first);
+
+		tile_map.clear();
+		memory_map.clear();
+		memory_data_map.clear();
+		display_buffers_map.clear();
+		replay_commands.clear();
+	}
+
+	u32 frame_capture_data::get_fifo_size() const
 	{
 		u32 buffer_size = 4;
 
 		// run through replay commands to figure out how big command buffer needs to be
-		for (const auto& rc : frame->replay_commands)
+		for (const auto& rc : replay_commands)
 		{
 			const u32 count = (rc.rsx_command.first >> 18) & 0x7ff;
 			// allocate for register plus w/e number of arguments it has
 			buffer_size += (count * 4) + 4;
 		}
 
+		return buffer_size;
+	}
+
+	bool frame_capture_reader::read_chunk(frame_capture_chunk_header& header, std::vector<u8>& data)
+	{
+		if (m_file.pos() >= m_file.size())
+		{
+			// End of capture
+			return false;
+		}
+
+		std::vector<u8> compressed;
+
+		if (!m_file.read(header) || header.compressed_size > m_file.size() - m_file.pos() || !m_file.read<true>(compressed, header.compressed_size))
+		{
+			rsx_log.error("Capture Replay: truncated chunk at offset 0x%llx", m_file.pos());
+			return false;
+		}
+
+		// Deflate cannot expand data by more than 1032:1, anything above that (or above 1GiB) is a corrupt header
+		constexpr u64 max_chunk_size = 0x4000'0000;
+		constexpr u64 max_deflate_ratio = 1032;
+
+		if (header.uncompressed_size > max_chunk_size || header.uncompressed_size > header.compressed_size * max_deflate_ratio)
+		{
+			rsx_log.error("Capture Replay: chunk size is invalid (compressed=0x%x, uncompressed=0x%x)", header.compressed_size, header.uncompressed_size);
+			return false;
+		}
+
+		data.resize(header.uncompressed_size);
+		uLongf size = header.uncompressed_size;
+
+		if (const int res = uncompress(data.data(), &size, compressed.data(), header.compressed_size); res != Z_OK || size != header.uncompressed_size)
+		{
+			rsx_log.error("Capture Replay: failed to decompress chunk (error %d)", res);
+			return false;
+		}
+
+		return true;
+	}
+
+	bool frame_capture_reader::open(const std::string& path, frame_capture_data& capture)
+	{
+		if (!m_file.open(path))
+		{
+			rsx_log.error("Capture Replay: failed to open %s (%s)", path, fs::g_tls_error);
+			return false;
+		}
+
+		m_path = path;
+
+		frame_capture_chunk_header header;
+		std::vector<u8> data;
+
+		if (!read_chunk(header, data))
+		{
+			return false;
+		}
+
+		utils::serial ar;
+		ar.set_reading_state(std::move(data));
+
+		// Stops after the identification fields if they do not match, the caller reports which one is wrong
+		ar(capture);
+
+		m_first_chunk_pos = m_file.pos();
+		return true;
+	}
+
+	bool frame_capture_reader::read_frame(frame_capture_data& capture)
+	{
+		frame_capture_chunk_header header;
+		std::vector<u8> data;
+
+		if (!read_chunk(header, data))
+		{
+			return false;
+		}
+
+		utils::serial ar;
+		ar.set_reading_state(std::move(data));
+
+		// Entries first stored by this frame, those of the previous frames are kept as they may still be referenced
+		decltype(capture.tile_map) tiles;
+		decltype(capture.memory_map) blocks;
+		decltype(capture.memory_data_map) block_data;
+		decltype(capture.display_buffers_map) display_buffers;
+
+		ar(tiles, blocks, block_data, display_buffers, capture.replay_commands);
+
+		capture.tile_map.merge(tiles);
+		capture.memory_map.merge(blocks);
+		capture.memory_data_map.merge(block_data);
+		capture.display_buffers_map.merge(display_buffers);
+		return true;
+	}
+
+	u32 frame_capture_reader::get_max_fifo_size()
+	{
+		u32 result = 4;
+
+		m_file.seek(m_first_chunk_pos);
+
+		for (frame_capture_chunk_header header; m_file.pos() < m_file.size() && m_file.read(header);)
+		{
+			result = std::max(result, header.fifo_size);
+			m_file.seek(header.compressed_size, fs::seek_cur);
+		}
+
+		rewind();
+		return result;
+	}
+
+	void frame_capture_reader::rewind()
+	{
+		m_file.seek(m_first_chunk_pos);
+	}
+
+	be_t<u32> rsx_replay_thread::allocate_context()
+	{
+		// The FIFO is rewritten for every frame, size it for the largest one
+		u32 buffer_size = reader->get_max_fifo_size();
+
 		// User memory + fifo size
 		buffer_size = utils::align<u32>(buffer_size, 0x100000) + 0x10000000;
 		// We are not allowed to drain all memory so add a little
@@ -171,73 +438,152 @@ namespace rsx
 	{
 		be_t<u32> context_id = allocate_context();
 
-		auto fifo_stops = alloc_write_fifo(context_id);
+		auto render = get_current_renderer();
+
+		// Benchmark mode replays the capture a fixed number of times back to back and reports per-frame statistics
+		std::unique_ptr<replay_benchmark> benchmark;
+		const u32 warmup_iterations = g_cfg.video.capture_benchmark.warmup_iterations;
+		const u32 iterations = g_cfg.video.capture_benchmark.iterations;
+
+		if (g_cfg.video.capture_benchmark.enabled)
+		{
+			benchmark = std::make_unique<replay_benchmark>();
+
+			render->set_frame_statistics_listener([bench = benchmark.get()](const frame_statistics_t& stats)
+			{
+				bench->last_stats = stats;
+				bench->presented_frames.release(bench->presented_frames + 1);
+				bench->presented_frames.notify_one();
+			});
+		}
 
-		while (!Emu.IsStopped())
+		for (u32 iteration = 0; !Emu.IsStopped(); iteration++)
 		{
+			if (benchmark && iteration == warmup_iterations + iterations)
+			{
+				break;
+			}
+
 			// Load registers while the RSX is still idle
 			method_registers = frame->reg_state;
 			atomic_fence_seq_cst();
 
-			// start up fifo buffer by dumping the put ptr to first stop
-			sys_rsx_context_attribute(context_id, 0x001, 0x10000000, fifo_stops[0], 0, 0);
-
-			auto render = get_current_renderer();
-			auto last_flip = render->int_flip_index;
+			reader->rewind();
 
-			usz stopIdx = 0;
-			for (const auto& replay_cmd : frame->replay_commands)
+			for (u32 frame_index = 0; !Emu.IsStopped(); frame_index++)
 			{
-				while (Emu.IsPaused())
-					thread_ctrl::wait_for(10'000);
+				if (!reader->read_frame(*frame))
+				{
+					if (frame_index == 0)
+					{
+						fmt::throw_exception("Capture Replay: capture contains no frames");
+					}
 
-				if (Emu.IsStopped())
 					break;
+				}
 
-				// Loop and hunt down our next state change that needs to be done
-				if (!(!replay_cmd.memory_state.empty() || (replay_cmd.display_buffer_state != 0) || (replay_cmd.tile_state != 0)))
+				if (!benchmark)
+				{
+					replay_frame(context_id);
+
+					// random pause to not destroy gpu
+					thread_ctrl::wait_for(10'000);
 					continue;
+				}
+
+				const u64 presented = benchmark->presented_frames;
+				const u64 start = get_system_time();
+
+				replay_frame(context_id);
 
-				// wait until rsx idle and at our first 'stop' to apply state
-				while (!Emu.IsStopped() && !render->is_fifo_idle() && (render->ctrl->get != fifo_stops[stopIdx]))
+				if (!benchmark->wait_for_present(presented))
 				{
-					while (Emu.IsPaused())
-						thread_ctrl::wait_for(10'000);
-					std::this_thread::yield();
+					break;
 				}
 
-				stopIdx++;
+				if (iteration >= warmup_iterations)
+				{
+					benchmark->samples.push_back({ iteration - warmup_iterations, frame_index, get_system_time() - start, benchmark->last_stats });
+				}
+			}
+		}
 
-				apply_frame_state(context_id, replay_cmd);
+		if (benchmark)
+		{
+			// Waits for a listener call still running on the RSX thread, the benchmark must outlive it
+			render->set_frame_statistics_listener(nullptr);
 
-				// move put ptr to next stop
-				if (stopIdx >= fifo_stops.size())
-					fmt::throw_exception("Capture Replay: StopIdx greater than size of fifo_stops");
+			if (!Emu.IsStopped())
+			{
+				benchmark->save(reader->get_path(), warmup_iterations, iterations);
 
-				render->ctrl->put = fifo_stops[stopIdx];
+				Emu.CallAfter([]()
+				{
+					Emu.Stop();
+				});
 			}
+		}
 
-			// dump put to end of stops, which should have actual end
-			u32 end = fifo_stops.back();
-			render->ctrl->put = end;
+		get_current_cpu_thread()->state += (cpu_flag::exit + cpu_flag::wait);
+	}
 
-			while (!render->is_fifo_idle() && !Emu.IsStopped())
+	void rsx_replay_thread::replay_frame(be_t<u32> context_id)
+	{
+		auto render = get_current_renderer();
+		const auto fifo_stops = alloc_write_fifo(context_id);
+		auto last_flip = render->int_flip_index;
+
+		// start up fifo buffer by dumping the put ptr to first stop
+		sys_rsx_context_attribute(context_id, 0x001, 0x10000000, fifo_stops[0], 0, 0);
+
+		usz stopIdx = 0;
+		for (const auto& replay_cmd : frame->replay_commands)
+		{
+			while (Emu.IsPaused())
+				thread_ctrl::wait_for(10'000);
+
+			if (Emu.IsStopped())
+				break;
+
+			// Loop and hunt down our next state change that needs to be done
+			if (!(!replay_cmd.memory_state.empty() || (replay_cmd.display_buffer_state != 0) || (replay_cmd.tile_state != 0)))
+				continue;
+
+			// wait until rsx idle and at our first 'stop' to apply state
+			while (!Emu.IsStopped() && !render->is_fifo_idle() && (render->ctrl->get != fifo_stops[stopIdx]))
 			{
 				while (Emu.IsPaused())
 					thread_ctrl::wait_for(10'000);
+				thread_ctrl::wait_for(50);
 			}
 
-			// Check if the captured application used syscall instead of a gcm command to flip
-			if (render->int_flip_index == last_flip)
-			{
-				// Capture did not include a display flip, flip manually
-				render->request_emu_flip(1u);
-			}
+			stopIdx++;
 
-			// random pause to not destroy gpu
-			thread_ctrl::wait_for(10'000);
+			apply_frame_state(context_id, replay_cmd);
+
+			// move put ptr to next stop
+			if (stopIdx >= fifo_stops.size())
+				fmt::throw_exception("Capture Replay: StopIdx greater than size of fifo_stops");
+
+			render->ctrl->put = fifo_stops[stopIdx];
 		}
 
-		get_current_cpu_thread()->state += (cpu_flag::exit + cpu_flag::wait);
+		// dump put to end of stops, which should have actual end
+		u32 end = fifo_stops.back();
+		render->ctrl->put = end;
+
+		while (!render->is_fifo_idle() && !Emu.IsStopped())
+		{
+			while (Emu.IsPaused())
+				thread_ctrl::wait_for(10'000);
+			thread_ctrl::wait_for(50);
+		}
+
+		// Check if the captured application used syscall instead of a gcm command to flip
+		if (render->int_flip_index == last_flip)
+		{
+			// Capture did not include a display flip, flip manually
+			render->request_emu_flip(1u);
+		}
 	}
 }
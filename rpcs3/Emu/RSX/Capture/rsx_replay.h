@@ -2,6 +2,7 @@
 
 #include "Emu/CPU/CPUThread.h"
 #include "Emu/RSX/rsx_methods.h"
+#include "Utilities/File.h"
 
 #include <unordered_map>
 #include <unordered_set>
@@ -11,7 +12,24 @@ namespace rsx
 	enum : u32
 	{
 		c_fc_magic = "RRC"_u32,
-		c_fc_version = 0x5,
+		c_fc_version = 0x6,
+	};
+
+	/**
+	 * Capture files are a sequence of zlib compressed chunks:
+	 *  - the first one holds the magic, version, byte order and the register state at the start of the capture
+	 *  - every following one holds a frame: its replay commands and the tile, display buffer and memory entries it is the
+	 *    first to reference. Entries are keyed by content hash and stored once per file, so a block that stays unchanged
+	 *    across frames costs nothing after the first one.
+	 * Chunks are read back one at a time during replay, only the command stream of the current frame is kept in memory.
+	 */
+	struct frame_capture_chunk_header
+	{
+		using enable_bitcopy = std::true_type;
+
+		u32 compressed_size;
+		u32 uncompressed_size;
+		u32 fifo_size;        // FIFO space in bytes needed to replay this frame
 	};
 
 	struct frame_capture_data
@@ -105,15 +123,76 @@ namespace rsx
 		// Initial registers state at the beginning of the capture
 		rsx::rsx_state reg_state;
 
+		// Keys of the entries already written by earlier chunks of the capture file (not serialized)
+		std::unordered_set<u64> stored_tiles;
+		std::unordered_set<u64> stored_blocks;
+		std::unordered_set<u64> stored_data;
+		std::unordered_set<u64> stored_display_buffers;
+
 		void reset()
 		{
 			magic = c_fc_magic;
 			version = c_fc_version;
 			tile_map.clear();
 			memory_map.clear();
+			memory_data_map.clear();
+			display_buffers_map.clear();
 			replay_commands.clear();
+			stored_tiles.clear();
+			stored_blocks.clear();
+			stored_data.clear();
+			stored_display_buffers.clear();
 			reg_state = method_registers;
 		}
+
+		// Drops the entries already stored by earlier chunks so that only new ones are serialized
+		void discard_stored_entries();
+
+		// Marks everything currently held as stored and clears it for the next frame
+		void on_chunk_stored();
+
+		// Returns the FIFO space in bytes needed to replay the current command list
+		u32 get_fifo_size() const;
+	};
+
+	// Streams a capture to disk, one chunk per frame
+	class frame_capture_writer
+	{
+		std::unique_ptr<fs::pending_file> m_file;
+		std::string m_path;
+		u32 m_frame_count = 0;
+
+	public:
+		bool open(const std::string& path, frame_capture_data& capture);
+		bool write_frame(frame_capture_data& capture);
+		bool commit();
+
+		u32 get_frame_count() const { return m_frame_count; }
+		const std::string& get_path() const { return m_path; }
+	};
+
+	// Reads a capture back incrementally, one chunk per frame
+	class frame_capture_reader
+	{
+		fs::file m_file;
+		std::string m_path;
+		u64 m_first_chunk_pos = 0;
+
+		bool read_chunk(frame_capture_chunk_header& header, std::vector<u8>& data);
+
+	public:
+		// Reads the header chunk. The capture holds the initial register state only if magic, version and byte order match
+		bool open(const std::string& path, frame_capture_data& capture);
+
+		// Loads the next frame: replaces the command list and merges any new entries into the capture
+		bool read_frame(frame_capture_data& capture);
+
+		// Largest FIFO space needed by any frame of the capture
+		u32 get_max_fifo_size();
+
+		void rewind();
+
+		const std::string& get_path() const { return m_path; }
 	};
 
 
@@ -142,11 +221,13 @@ namespace rsx
 		u32 user_mem_addr{};
 		current_state cs{};
 		std::unique_ptr<frame_capture_data> frame;
+		std::unique_ptr<frame_capture_reader> reader;
 
 	public:
-		rsx_replay_thread(std::unique_ptr<frame_capture_data>&& frame_data)
+		rsx_replay_thread(std::unique_ptr<frame_capture_data>&& frame_data, std::unique_ptr<frame_capture_reader>&& frame_reader)
 			: cpu_thread(0)
 			, frame(std::move(frame_data))
+			, reader(std::move(frame_reader))
 		{
 		}
 
@@ -155,5 +236,6 @@ namespace rsx
 		be_t<u32> allocate_context();
 		std::vector<u32> alloc_write_fifo(be_t<u32> context_id) const;
 		void apply_frame_state(be_t<u32> context_id, const frame_capture_data::replay_command& replay_cmd);
+		void replay_frame(be_t<u32> context_id);
 	};
 }
@@ -0,0 +1,356 @@
+#include "stdafx.h"
+#include "BlitUtils.h"
+
+#include "emmintrin.h"
+
+#include <vector>
+
+#if !defined(_MSC_VER) && defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wold-style-cast"
+#endif
+
+namespace
+{
+	using rsx::blit_pixel_format;
+
+	// Intermediate rows are kept as A8R8G8B8 in memory order, blending works on bytes and does not care about channel order
+
+	constexpr u32 expand_r5g6b5(u16 value)
+	{
+		const u32 r = value >> 11;
+		const u32 g = (value >> 5) & 0x3F;
+		const u32 b = value & 0x1F;
+
+		return 0xFF | ((r << 3 | r >> 2) << 8) | ((g << 2 | g >> 4) << 16) | ((b << 3 | b >> 2) << 24);
+	}
+
+	constexpr u16 pack_r5g6b5(u32 value)
+	{
+		return static_cast<u16>(((value >> 11) & 0x1F) << 11 | ((value >> 18) & 0x3F) << 5 | (value >> 27));
+	}
+
+	constexpr u32 lerp_pixel(u32 a, u32 b, u32 weight)
+	{
+		u32 result = 0;
+
+		for (u32 shift = 0; shift < 32; shift += 8)
+		{
+			const u32 ca = (a >> shift) & 0xFF;
+			const u32 cb = (b >> shift) & 0xFF;
+			result |= ((ca * (256 - weight) + cb * weight) >> 8) << shift;
+		}
+
+		return result;
+	}
+
+	void decode_row(u32* dst, const u8* src, blit_pixel_format format, u32 count)
+	{
+		if (format == blit_pixel_format::a8r8g8b8)
+		{
+			std::memcpy(dst, src, count * 4);
+			return;
+		}
+
+		const __m128i mask_g = _mm_set1_epi16(0x3F);
+		const __m128i mask_b = _mm_set1_epi16(0x1F);
+		const __m128i alpha = _mm_set1_epi16(0xFF);
+
+		u32 x = 0;
+		for (; x + 8 <= count; x += 8)
+		{
+			__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x * 2));
+			v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+
+			const __m128i r = _mm_srli_epi16(v, 11);
+			const __m128i g = _mm_and_si128(_mm_srli_epi16(v, 5), mask_g);
+			const __m128i b = _mm_and_si128(v, mask_b);
+
+			const __m128i r8 = _mm_or_si128(_mm_slli_epi16(r, 3), _mm_srli_epi16(r, 2));
+			const __m128i g8 = _mm_or_si128(_mm_slli_epi16(g, 2), _mm_srli_epi16(g, 4));
+			const __m128i b8 = _mm_or_si128(_mm_slli_epi16(b, 3), _mm_srli_epi16(b, 2));
+
+			const __m128i ar = _mm_or_si128(alpha, _mm_slli_epi16(r8, 8));
+			const __m128i gb = _mm_or_si128(g8, _mm_slli_epi16(b8, 8));
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), _mm_unpacklo_epi16(ar, gb));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x + 4), _mm_unpackhi_epi16(ar, gb));
+		}
+
+		for (; x < count; ++x)
+		{
+			dst[x] = expand_r5g6b5(static_cast<u16>(src[x * 2] << 8 | src[x * 2 + 1]));
+		}
+	}
+
+	void encode_row(u8* dst, const u32* src, blit_pixel_format format, u32 count)
+	{
+		if (format == blit_pixel_format::a8r8g8b8)
+		{
+			std::memcpy(dst, src, count * 4);
+			return;
+		}
+
+		const __m128i mask_r = _mm_set1_epi32(0x1F);
+		const __m128i mask_g = _mm_set1_epi32(0x3F);
+
+		const auto pack = [&](__m128i v)
+		{
+			const __m128i r = _mm_and_si128(_mm_srli_epi32(v, 11), mask_r);
+			const __m128i g = _mm_and_si128(_mm_srli_epi32(v, 18), mask_g);
+			const __m128i b = _mm_srli_epi32(v, 27);
+			const __m128i result = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(r, 11), _mm_slli_epi32(g, 5)), b);
+
+			// Sign extend so that the saturating pack keeps the bit pattern
+			return _mm_srai_epi32(_mm_slli_epi32(result, 16), 16);
+		};
+
+		u32 x = 0;
+		for (; x + 8 <= count; x += 8)
+		{
+			const __m128i lo = pack(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x)));
+			const __m128i hi = pack(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x + 4)));
+			const __m128i v = _mm_packs_epi32(lo, hi);
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 2), _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)));
+		}
+
+		for (; x < count; ++x)
+		{
+			const u16 value = pack_r5g6b5(src[x]);
+			dst[x * 2] = static_cast<u8>(value >> 8);
+			dst[x * 2 + 1] = static_cast<u8>(value);
+		}
+	}
+
+	// dst = a + (b - a) * weight / 256, weight is shared by all pixels
+	void lerp_rows(u32* dst, const u32* a, const u32* b, u32 weight, u32 count)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i wa = _mm_set1_epi16(static_cast<s16>(256 - weight));
+		const __m128i wb = _mm_set1_epi16(static_cast<s16>(weight));
+
+		u32 x = 0;
+		for (; x + 4 <= count; x += 4)
+		{
+			const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + x));
+			const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + x));
+
+			const __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(va, zero), wa), _mm_mullo_epi16(_mm_unpacklo_epi8(vb, zero), wb));
+			const __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(va, zero), wa), _mm_mullo_epi16(_mm_unpackhi_epi8(vb, zero), wb));
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8)));
+		}
+
+		for (; x < count; ++x)
+		{
+			dst[x] = lerp_pixel(a[x], b[x], weight);
+		}
+	}
+
+	// dst[i] = a[i] + (b[i] - a[i]) * weights[i] / 256
+	void lerp_pairs(u32* dst, const u32* a, const u32* b, const u16* weights, u32 count)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i full = _mm_set1_epi16(256);
+
+		u32 x = 0;
+		for (; x + 4 <= count; x += 4)
+		{
+			const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + x));
+			const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + x));
+
+			// Broadcast each pixel weight to its 4 channels
+			const __m128i w = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(weights + x));
+			const __m128i w2 = _mm_unpacklo_epi16(w, w);
+			const __m128i wb_lo = _mm_unpacklo_epi32(w2, w2);
+			const __m128i wb_hi = _mm_unpackhi_epi32(w2, w2);
+
+			const __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(va, zero), _mm_sub_epi16(full, wb_lo)), _mm_mullo_epi16(_mm_unpacklo_epi8(vb, zero), wb_lo));
+			const __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(va, zero), _mm_sub_epi16(full, wb_hi)), _mm_mullo_epi16(_mm_unpackhi_epi8(vb, zero), wb_hi));
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8)));
+		}
+
+		for (; x < count; ++x)
+		{
+			dst[x] = lerp_pixel(a[x], b[x], weights[x]);
+		}
+	}
+
+	struct sample_t
+	{
+		u32 index0;
+		u32 index1;
+		u16 weight; // Weight of index1 in 1/256 units
+	};
+
+	// Maps output coordinates [first, first + count) to input coordinates, sampling at pixel centers
+	std::vector<sample_t> compute_samples(u32 in_size, u32 out_size, u32 first, u32 count, bool bilinear)
+	{
+		std::vector<sample_t> result(count);
+
+		for (u32 i = 0; i < count; ++i)
+		{
+			const u64 out = first + i;
+
+			if (!bilinear)
+			{
+				const u32 index = static_cast<u32>(((out * 2 + 1) * in_size) / (u64{out_size} * 2));
+				result[i] = { index, index, 0 };
+				continue;
+			}
+
+			// 16.16 fixed point position of the output pixel center in input space
+			const s64 pos = static_cast<s64>(((out * 2 + 1) * in_size << 16) / (u64{out_size} * 2)) - 0x8000;
+			const u32 index = static_cast<u32>(std::max<s64>(pos, 0) >> 16);
+
+			if (pos < 0 || index >= in_size - 1)
+			{
+				const u32 edge = std::min(index, in_size - 1);
+				result[i] = { edge, edge, 0 };
+				continue;
+			}
+
+			result[i] = { index, index + 1, static_cast<u16>((pos >> 8) & 0xFF) };
+		}
+
+		return result;
+	}
+}
+
+namespace rsx
+{
+	void convert_scale_image(const blit_target_desc& dst, const blit_image_desc& src, u32 slice_height, bool bilinear)
+	{
+		if (!src.width || !src.height || !dst.width || !dst.height || dst.clip_x >= dst.width || dst.clip_y >= dst.height)
+		{
+			return;
+		}
+
+		const u32 src_bpp = src.format == blit_pixel_format::r5g6b5 ? 2 : 4;
+		const u32 dst_bpp = dst.format == blit_pixel_format::r5g6b5 ? 2 : 4;
+		const u32 out_w = std::min(dst.clip_width, dst.width - dst.clip_x);
+		const u32 out_h = std::min(dst.clip_height, dst.height - dst.clip_y);
+		const u32 rows_available = std::min(src.height, slice_height);
+
+		if (!out_w || !out_h || !rows_available)
+		{
+			return;
+		}
+
+		const auto columns = compute_samples(src.width, dst.width, dst.clip_x, out_w, bilinear);
+		const auto rows = compute_samples(src.height, dst.height, dst.clip_y, out_h, bilinear);
+
+		// Only decode the source columns that are actually sampled
+		const u32 first_column = columns.front().index0;
+		const u32 column_count = columns.back().index1 - first_column + 1;
+		const bool identity_x = column_count == out_w && src.width == dst.width;
+
+		if (identity_x && src.height == dst.height && src.format == dst.format)
+		{
+			// Straight copy of the clip region
+			for (u32 y = 0; y < out_h && rows[y].index0 < rows_available; ++y)
+			{
+				std::memcpy(dst.pixels + y * dst.pitch, src.pixels + rows[y].index0 * src.pitch + first_column * src_bpp, out_w * dst_bpp);
+			}
+
+			return;
+		}
+
+		std::vector<u32> decoded(column_count);
+		std::vector<u32> lerp_a, lerp_b;
+		std::vector<u16> weights;
+
+		if (bilinear && !identity_x)
+		{
+			lerp_a.resize(out_w);
+			lerp_b.resize(out_w);
+			weights.resize(out_w);
+
+			for (u32 x = 0; x < out_w; ++x)
+			{
+				weights[x] = columns[x].weight;
+			}
+		}
+
+		// Horizontally scaled source rows, tagged with the source row they were produced from
+		std::vector<u32> scaled[2] = { std::vector<u32>(out_w), std::vector<u32>(out_w) };
+		u32 scaled_row[2] = { umax, umax };
+		std::vector<u32> blended(out_w);
+
+		const auto scale_row = [&](u32 row, u32 slot)
+		{
+			if (scaled_row[slot] == row)
+			{
+				return;
+			}
+
+			if (slot == 0 && scaled_row[1] == row)
+			{
+				// Moving down one source row, the previous bottom row becomes the top row
+				std::swap(scaled[0], scaled[1]);
+				std::swap(scaled_row[0], scaled_row[1]);
+				return;
+			}
+
+			u32* out = scaled[slot].data();
+			decode_row(identity_x ? out : decoded.data(), src.pixels + row * src.pitch + first_column * src_bpp, src.format, column_count);
+
+			if (identity_x)
+			{
+				// Already in place
+			}
+			else if (!bilinear)
+			{
+				for (u32 x = 0; x < out_w; ++x)
+				{
+					out[x] = decoded[columns[x].index0 - first_column];
+				}
+			}
+			else
+			{
+				for (u32 x = 0; x < out_w; ++x)
+				{
+					lerp_a[x] = decoded[columns[x].index0 - first_column];
+					lerp_b[x] = decoded[columns[x].index1 - first_column];
+				}
+
+				lerp_pairs(out, lerp_a.data(), lerp_b.data(), weights.data(), out_w);
+			}
+
+			scaled_row[slot] = row;
+		};
+
+		for (u32 y = 0; y < out_h; ++y)
+		{
+			const auto& sample = rows[y];
+
+			if (sample.index1 >= rows_available)
+			{
+				// Past the end of the source slice
+				break;
+			}
+
+			const u32* result = nullptr;
+			scale_row(sample.index0, 0);
+
+			if (!sample.weight)
+			{
+				result = scaled[0].data();
+			}
+			else
+			{
+				scale_row(sample.index1, 1);
+				lerp_rows(blended.data(), scaled[0].data(), scaled[1].data(), sample.weight, out_w);
+				result = blended.data();
+			}
+
+			encode_row(dst.pixels + y * dst.pitch, result, dst.format, out_w);
+		}
+	}
+}
+
+#if !defined(_MSC_VER) && defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "util/types.hpp"
+
+namespace rsx
+{
+	// Pixel formats handled by the software blit engine (NV3089 color formats as laid out in guest memory)
+	enum class blit_pixel_format : u8
+	{
+		r5g6b5,     // 16-bit big endian
+		a8r8g8b8    // Bytes stored in A, R, G, B order
+	};
+
+	struct blit_image_desc
+	{
+		const u8* pixels;
+		blit_pixel_format format;
+		u32 width;
+		u32 height;
+		u32 pitch;
+	};
+
+	struct blit_target_desc
+	{
+		u8* pixels;
+		blit_pixel_format format;
+		u32 pitch;
+
+		// Dimensions of the scaled image
+		u32 width;
+		u32 height;
+
+		// Region of the scaled image written to pixels. Parts outside the scaled image are left untouched
+		u32 clip_x;
+		u32 clip_y;
+		u32 clip_width;
+		u32 clip_height;
+	};
+
+	/**
+	 * Converts and scales src to the dimensions of dst using point or bilinear sampling, then writes the clip region of the result.
+	 * Only the first slice_height rows of the source are read.
+	 */
+	void convert_scale_image(const blit_target_desc& dst, const blit_image_desc& src, u32 slice_height, bool bilinear);
+}
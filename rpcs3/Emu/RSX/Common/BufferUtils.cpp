@@ -772,6 +772,99 @@ namespace
 			return std::make_tuple(min_index, max_index, count);
 		}
 
+		AVX2_FUNC
+		static
+		std::tuple<u16, u16, u32> upload_u16_swapped_avx2(const void *src, void *dst, u32 count)
+		{
+			const __m256i mask = _mm256_set_epi8(
+				0xE, 0xF, 0xC, 0xD,
+				0xA, 0xB, 0x8, 0x9,
+				0x6, 0x7, 0x4, 0x5,
+				0x2, 0x3, 0x0, 0x1,
+				0xE, 0xF, 0xC, 0xD,
+				0xA, 0xB, 0x8, 0x9,
+				0x6, 0x7, 0x4, 0x5,
+				0x2, 0x3, 0x0, 0x1);
+
+			auto src_stream = static_cast<const __m256i*>(src);
+			auto dst_stream = static_cast<__m256i*>(dst);
+
+			__m256i min = _mm256_set1_epi16(-1);
+			__m256i max = _mm256_set1_epi16(0);
+
+			const auto iterations = count / 16;
+			for (unsigned n = 0; n < iterations; ++n)
+			{
+				const __m256i raw = _mm256_loadu_si256(src_stream++);
+				const __m256i value = _mm256_shuffle_epi8(raw, mask);
+				max = _mm256_max_epu16(max, value);
+				min = _mm256_min_epu16(min, value);
+				_mm256_storeu_si256(dst_stream++, value);
+			}
+
+			__m128i tmp = _mm256_extracti128_si256(min, 1);
+			__m128i min2 = _mm256_castsi256_si128(min);
+			min2 = _mm_min_epu16(min2, tmp);
+
+			tmp = _mm256_extracti128_si256(max, 1);
+			__m128i max2 = _mm256_castsi256_si128(max);
+			max2 = _mm_max_epu16(max2, tmp);
+
+			const u16 min_index = sse41_hmin_epu16(min2);
+			const u16 max_index = sse41_hmax_epu16(max2);
+
+			return std::make_tuple(min_index, max_index, count);
+		}
+
+		AVX2_FUNC
+		static
+		std::tuple<u32, u32, u32> upload_u32_swapped_avx2(const void *src, void *dst, u32 count)
+		{
+			const __m256i mask = _mm256_set_epi8(
+				0xC, 0xD, 0xE, 0xF,
+				0x8, 0x9, 0xA, 0xB,
+				0x4, 0x5, 0x6, 0x7,
+				0x0, 0x1, 0x2, 0x3,
+				0xC, 0xD, 0xE, 0xF,
+				0x8, 0x9, 0xA, 0xB,
+				0x4, 0x5, 0x6, 0x7,
+				0x0, 0x1, 0x2, 0x3);
+
+			auto src_stream = static_cast<const __m256i*>(src);
+			auto dst_stream = static_cast<__m256i*>(dst);
+
+			__m256i min = _mm256_set1_epi32(~0u);
+			__m256i max = _mm256_set1_epi32(0);
+
+			const auto iterations = count / 8;
+			for (unsigned n = 0; n < iterations; ++n)
+			{
+				const __m256i raw = _mm256_loadu_si256(src_stream++);
+				const __m256i value = _mm256_shuffle_epi8(raw, mask);
+				max = _mm256_max_epu32(max, value);
+				min = _mm256_min_epu32(min, value);
+				_mm256_storeu_si256(dst_stream++, value);
+			}
+
+			__m128i min2 = _mm_min_epu32(_mm256_castsi256_si128(min), _mm256_extracti128_si256(min, 1));
+			__m128i max2 = _mm_max_epu32(_mm256_castsi256_si128(max), _mm256_extracti128_si256(max, 1));
+
+			__m128i tmp = _mm_srli_si128(min2, 8);
+			min2 = _mm_min_epu32(min2, tmp);
+			tmp = _mm_srli_si128(min2, 4);
+			min2 = _mm_min_epu32(min2, tmp);
+
+			tmp = _mm_srli_si128(max2, 8);
+			max2 = _mm_max_epu32(max2, tmp);
+			tmp = _mm_srli_si128(max2, 4);
+			max2 = _mm_max_epu32(max2, tmp);
+
+			const u32 min_index = _mm_cvtsi128_si32(min2);
+			const u32 max_index = _mm_cvtsi128_si32(max2);
+
+			return std::make_tuple(min_index, max_index, count);
+		}
+
 		template<typename T>
 		static
 		std::tuple<T, T, u32> upload_untouched(std::span<to_be_t<const T>> src, std::span<T> dst)
@@ -780,7 +873,26 @@ namespace
 			u32 written;
 			u32 remaining = ::size32(src);
 
-			if (s_use_sse4_1 && remaining >= 32)
+			if (s_use_avx2 && remaining >= 32)
+			{
+				if constexpr (std::is_same<T, u32>::value)
+				{
+					const auto count = (remaining & ~0x7);
+					std::tie(min_index, max_index, written) = upload_u32_swapped_avx2(src.data(), dst.data(), count);
+				}
+				else if constexpr (std::is_same<T, u16>::value)
+				{
+					const auto count = (remaining & ~0xF);
+					std::tie(min_index, max_index, written) = upload_u16_swapped_avx2(src.data(), dst.data(), count);
+				}
+				else
+				{
+					fmt::throw_exception("Unreachable");
+				}
+
+				remaining -= written;
+			}
+			else if (s_use_sse4_1 && remaining >= 32)
 			{
 				if constexpr (std::is_same<T, u32>::value)
 				{
@@ -900,6 +1012,58 @@ namespace
 			return std::make_tuple(min_index, max_index);
 		}
 
+		AVX2_FUNC
+		static
+		std::tuple<u32, u32> upload_u32_swapped_avx2(const void *src, void *dst, u32 iterations, u32 restart_index)
+		{
+			const __m256i shuffle_mask = _mm256_set_epi8(
+				0xC, 0xD, 0xE, 0xF,
+				0x8, 0x9, 0xA, 0xB,
+				0x4, 0x5, 0x6, 0x7,
+				0x0, 0x1, 0x2, 0x3,
+				0xC, 0xD, 0xE, 0xF,
+				0x8, 0x9, 0xA, 0xB,
+				0x4, 0x5, 0x6, 0x7,
+				0x0, 0x1, 0x2, 0x3);
+
+			auto src_stream = static_cast<const __m256i*>(src);
+			auto dst_stream = static_cast<__m256i*>(dst);
+
+			__m256i restart = _mm256_set1_epi32(restart_index);
+			__m256i min = _mm256_set1_epi32(0xffffffff);
+			__m256i max = _mm256_set1_epi32(0);
+
+			for (unsigned n = 0; n < iterations; ++n)
+			{
+				const __m256i raw = _mm256_loadu_si256(src_stream++);
+				const __m256i value = _mm256_shuffle_epi8(raw, shuffle_mask);
+				const __m256i mask = _mm256_cmpeq_epi32(restart, value);
+				const __m256i value_with_min_restart = _mm256_andnot_si256(mask, value);
+				const __m256i value_with_max_restart = _mm256_or_si256(mask, value);
+				max = _mm256_max_epu32(max, value_with_min_restart);
+				min = _mm256_min_epu32(min, value_with_max_restart);
+				_mm256_storeu_si256(dst_stream++, value_with_max_restart);
+			}
+
+			__m128i min2 = _mm_min_epu32(_mm256_castsi256_si128(min), _mm256_extracti128_si256(min, 1));
+			__m128i max2 = _mm_max_epu32(_mm256_castsi256_si128(max), _mm256_extracti128_si256(max, 1));
+
+			__m128i tmp = _mm_srli_si128(min2, 8);
+			min2 = _mm_min_epu32(min2, tmp);
+			tmp = _mm_srli_si128(min2, 4);
+			min2 = _mm_min_epu32(min2, tmp);
+
+			tmp = _mm_srli_si128(max2, 8);
+			max2 = _mm_max_epu32(max2, tmp);
+			tmp = _mm_srli_si128(max2, 4);
+			max2 = _mm_max_epu32(max2, tmp);
+
+			const u32 min_index = _mm_cvtsi128_si32(min2);
+			const u32 max_index = _mm_cvtsi128_si32(max2);
+
+			return std::make_tuple(min_index, max_index);
+		}
+
 		SSE4_1_FUNC
 		static
 		std::tuple<u32, u32> upload_u32_swapped_sse4_1(const void *src, void *dst, u32 iterations, u32 restart_index)
@@ -973,7 +1137,13 @@ namespace
 				}
 				else if constexpr (std::is_same<T, u32>::value)
 				{
-					if (s_use_sse4_1)
+					if (s_use_avx2)
+					{
+						u32 iterations = length >> 3;
+						written = length & ~0x7;
+						std::tie(min_index, max_index) = upload_u32_swapped_avx2(src.data(), dst.data(), iterations, restart_index);
+					}
+					else if (s_use_sse4_1)
 					{
 						u32 iterations = length >> 2;
 						written = length & ~0x3;
@@ -1006,6 +1176,295 @@ namespace
 		}
 	};
 
+	struct expand_impl
+	{
+		// Scan the big-endian stream for the restart index without swapping it
+		template<typename T>
+		static
+		bool contains_restart_index(std::span<to_be_t<const T>> src, u32 restart_index)
+		{
+			if (restart_index > index_limit<T>())
+			{
+				return false;
+			}
+
+			const T needle = stx::se_storage<T>::swap(static_cast<T>(restart_index));
+			const u32 length = ::size32(src);
+			auto src_stream = reinterpret_cast<const __m128i*>(src.data());
+			u32 i = 0;
+
+			if constexpr (std::is_same<T, u16>::value)
+			{
+				const __m128i mask = _mm_set1_epi16(static_cast<s16>(needle));
+				for (; (i + 8) <= length; i += 8)
+				{
+					const __m128i raw = _mm_loadu_si128(src_stream++);
+					if (_mm_movemask_epi8(_mm_cmpeq_epi16(raw, mask)))
+					{
+						return true;
+					}
+				}
+			}
+			else
+			{
+				const __m128i mask = _mm_set1_epi32(static_cast<s32>(needle));
+				for (; (i + 4) <= length; i += 4)
+				{
+					const __m128i raw = _mm_loadu_si128(src_stream++);
+					if (_mm_movemask_epi8(_mm_cmpeq_epi32(raw, mask)))
+					{
+						return true;
+					}
+				}
+			}
+
+			for (; i < length; ++i)
+			{
+				if (src[i] == restart_index)
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		// Each iteration consumes 2 quads (8 indices) and emits 4 triangles (12 indices)
+		SSE4_1_FUNC
+		static
+		std::tuple<u16, u16> expand_quads_u16_sse4_1(const void *src, void *dst, u32 iterations)
+		{
+			const __m128i swap_mask = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+			const __m128i tri0_mask = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 5, 4, 7, 6, 1, 0, 9, 8, 11, 10);
+			const __m128i tri1_mask = _mm_setr_epi8(13, 12, 13, 12, 15, 14, 9, 8, -1, -1, -1, -1, -1, -1, -1, -1);
+
+			auto src_stream = static_cast<const __m128i*>(src);
+			auto dst_stream = static_cast<u8*>(dst);
+
+			__m128i min = _mm_set1_epi16(-1);
+			__m128i max = _mm_set1_epi16(0);
+
+			for (unsigned n = 0; n < iterations; ++n)
+			{
+				const __m128i raw = _mm_loadu_si128(src_stream++);
+				const __m128i value = _mm_shuffle_epi8(raw, swap_mask);
+				max = _mm_max_epu16(max, value);
+				min = _mm_min_epu16(min, value);
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst_stream), _mm_shuffle_epi8(raw, tri0_mask));
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(dst_stream + 16), _mm_shuffle_epi8(raw, tri1_mask));
+				dst_stream += 24;
+			}
+
+			return std::make_tuple(sse41_hmin_epu16(min), sse41_hmax_epu16(max));
+		}
+
+		// Each iteration consumes 1 quad (4 indices) and emits 2 triangles (6 indices)
+		SSE4_1_FUNC
+		static
+		std::tuple<u32, u32> expand_quads_u32_sse4_1(const void *src, void *dst, u32 iterations)
+		{
+			const __m128i swap_mask = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+			const __m128i tri0_mask = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 11, 10, 9, 8);
+			const __m128i tri1_mask = _mm_setr_epi8(15, 14, 13, 12, 3, 2, 1, 0, -1, -1, -1, -1, -1, -1, -1, -1);
+
+			auto src_stream = static_cast<const __m128i*>(src);
+			auto dst_stream = static_cast<u8*>(dst);
+
+			__m128i min = _mm_set1_epi32(0xffffffff);
+			__m128i max = _mm_set1_epi32(0);
+
+			for (unsigned n = 0; n < iterations; ++n)
+			{
+				const __m128i raw = _mm_loadu_si128(src_stream++);
+				const __m128i value = _mm_shuffle_epi8(raw, swap_mask);
+				max = _mm_max_epu32(max, value);
+				min = _mm_min_epu32(min, value);
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst_stream), _mm_shuffle_epi8(raw, tri0_mask));
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(dst_stream + 16), _mm_shuffle_epi8(raw, tri1_mask));
+				dst_stream += 24;
+			}
+
+			__m128i tmp = _mm_srli_si128(min, 8);
+			min = _mm_min_epu32(min, tmp);
+			tmp = _mm_srli_si128(min, 4);
+			min = _mm_min_epu32(min, tmp);
+
+			tmp = _mm_srli_si128(max, 8);
+			max = _mm_max_epu32(max, tmp);
+			tmp = _mm_srli_si128(max, 4);
+			max = _mm_max_epu32(max, tmp);
+
+			return std::make_tuple(static_cast<u32>(_mm_cvtsi128_si32(min)), static_cast<u32>(_mm_cvtsi128_si32(max)));
+		}
+
+		// Each iteration reads 8 outer indices and emits 4 triangles (12 indices). Only the first 5 reads are consumed.
+		SSE4_1_FUNC
+		static
+		std::tuple<u16, u16> expand_triangle_fan_u16_sse4_1(const void *src, void *dst, u32 iterations, u16 anchor)
+		{
+			const __m128i swap_mask = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+			const __m128i tri0_mask = _mm_setr_epi8(-1, -1, 1, 0, 3, 2, -1, -1, 3, 2, 5, 4, -1, -1, 5, 4);
+			const __m128i tri1_mask = _mm_setr_epi8(7, 6, -1, -1, 7, 6, 9, 8, -1, -1, -1, -1, -1, -1, -1, -1);
+			const __m128i anchor0 = _mm_setr_epi16(anchor, 0, 0, anchor, 0, 0, anchor, 0);
+			const __m128i anchor1 = _mm_setr_epi16(0, anchor, 0, 0, 0, 0, 0, 0);
+
+			auto src_stream = static_cast<const u8*>(src);
+			auto dst_stream = static_cast<u8*>(dst);
+
+			__m128i min = _mm_set1_epi16(anchor);
+			__m128i max = _mm_set1_epi16(anchor);
+
+			for (unsigned n = 0; n < iterations; ++n)
+			{
+				const __m128i raw = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src_stream));
+				const __m128i value = _mm_shuffle_epi8(raw, swap_mask);
+				max = _mm_max_epu16(max, value);
+				min = _mm_min_epu16(min, value);
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst_stream), _mm_or_si128(_mm_shuffle_epi8(raw, tri0_mask), anchor0));
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(dst_stream + 16), _mm_or_si128(_mm_shuffle_epi8(raw, tri1_mask), anchor1));
+				src_stream += 8;
+				dst_stream += 24;
+			}
+
+			return std::make_tuple(sse41_hmin_epu16(min), sse41_hmax_epu16(max));
+		}
+
+		// Each iteration reads 4 outer indices and emits 2 triangles (6 indices). Only the first 3 reads are consumed.
+		SSE4_1_FUNC
+		static
+		std::tuple<u32, u32> expand_triangle_fan_u32_sse4_1(const void *src, void *dst, u32 iterations, u32 anchor)
+		{
+			const __m128i swap_mask = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+			const __m128i tri0_mask = _mm_setr_epi8(-1, -1, -1, -1, 3, 2, 1, 0, 7, 6, 5, 4, -1, -1, -1, -1);
+			const __m128i tri1_mask = _mm_setr_epi8(7, 6, 5, 4, 11, 10, 9, 8, -1, -1, -1, -1, -1, -1, -1, -1);
+			const __m128i anchor0 = _mm_setr_epi32(anchor, 0, 0, anchor);
+
+			auto src_stream = static_cast<const u8*>(src);
+			auto dst_stream = static_cast<u8*>(dst);
+
+			__m128i min = _mm_set1_epi32(anchor);
+			__m128i max = _mm_set1_epi32(anchor);
+
+			for (unsigned n = 0; n < iterations; ++n)
+			{
+				const __m128i raw = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src_stream));
+				const __m128i value = _mm_shuffle_epi8(raw, swap_mask);
+				max = _mm_max_epu32(max, value);
+				min = _mm_min_epu32(min, value);
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst_stream), _mm_or_si128(_mm_shuffle_epi8(raw, tri0_mask), anchor0));
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(dst_stream + 16), _mm_shuffle_epi8(raw, tri1_mask));
+				src_stream += 8;
+				dst_stream += 24;
+			}
+
+			__m128i tmp = _mm_srli_si128(min, 8);
+			min = _mm_min_epu32(min, tmp);
+			tmp = _mm_srli_si128(min, 4);
+			min = _mm_min_epu32(min, tmp);
+
+			tmp = _mm_srli_si128(max, 8);
+			max = _mm_max_epu32(max, tmp);
+			tmp = _mm_srli_si128(max, 4);
+			max = _mm_max_epu32(max, tmp);
+
+			return std::make_tuple(static_cast<u32>(_mm_cvtsi128_si32(min)), static_cast<u32>(_mm_cvtsi128_si32(max)));
+		}
+
+		// Expansion of a quad list that is known not to contain any restart index
+		template<typename T>
+		static
+		std::tuple<T, T, u32> expand_quads(std::span<to_be_t<const T>> src, std::span<T> dst)
+		{
+			T min_index = index_limit<T>();
+			T max_index = 0;
+			u32 read = 0;
+			u32 dst_idx = 0;
+			const u32 length = ::size32(src);
+
+			if constexpr (std::is_same<T, u16>::value)
+			{
+				const u32 iterations = length / 8;
+				std::tie(min_index, max_index) = expand_quads_u16_sse4_1(src.data(), dst.data(), iterations);
+				read = iterations * 8;
+				dst_idx = iterations * 12;
+			}
+			else
+			{
+				const u32 iterations = length / 4;
+				std::tie(min_index, max_index) = expand_quads_u32_sse4_1(src.data(), dst.data(), iterations);
+				read = iterations * 4;
+				dst_idx = iterations * 6;
+			}
+
+			for (; (read + 4) <= length; read += 4)
+			{
+				const T i0 = src[read], i1 = src[read + 1], i2 = src[read + 2], i3 = src[read + 3];
+				dst[dst_idx++] = min_max(min_index, max_index, i0);
+				dst[dst_idx++] = min_max(min_index, max_index, i1);
+				dst[dst_idx++] = min_max(min_index, max_index, i2);
+				dst[dst_idx++] = i2;
+				dst[dst_idx++] = min_max(min_index, max_index, i3);
+				dst[dst_idx++] = i0;
+			}
+
+			// Incomplete trailing quad does not emit anything but still counts towards the range
+			for (; read < length; ++read)
+			{
+				const T index = src[read];
+				min_max(min_index, max_index, index);
+			}
+
+			return std::make_tuple(min_index, max_index, dst_idx);
+		}
+
+		// Expansion of a triangle fan that is known not to contain any restart index
+		template<typename T>
+		static
+		std::tuple<T, T, u32> expand_triangle_fan(std::span<to_be_t<const T>> src, std::span<T> dst)
+		{
+			const T anchor = src[0];
+			const u32 length = ::size32(src);
+
+			T min_index = anchor;
+			T max_index = anchor;
+			u32 dst_idx = 0;
+			u32 outer = 1;
+
+			if constexpr (std::is_same<T, u16>::value)
+			{
+				const u32 iterations = (length - 5) / 4;
+				std::tie(min_index, max_index) = expand_triangle_fan_u16_sse4_1(&src[1], dst.data(), iterations, anchor);
+				outer += iterations * 4;
+				dst_idx = iterations * 12;
+			}
+			else
+			{
+				const u32 iterations = (length - 3) / 2;
+				std::tie(min_index, max_index) = expand_triangle_fan_u32_sse4_1(&src[1], dst.data(), iterations, anchor);
+				outer += iterations * 2;
+				dst_idx = iterations * 6;
+			}
+
+			T last_index = src[outer];
+			min_max(min_index, max_index, last_index);
+
+			for (u32 i = outer + 1; i < length; ++i)
+			{
+				const T index = src[i];
+				dst[dst_idx++] = anchor;
+				dst[dst_idx++] = last_index;
+				dst[dst_idx++] = min_max(min_index, max_index, index);
+				last_index = index;
+			}
+
+			return std::make_tuple(min_index, max_index, dst_idx);
+		}
+	};
+
 	template<typename T>
 	std::tuple<T, T, u32> upload_untouched(std::span<to_be_t<const T>> src, std::span<T> dst, rsx::primitive_type draw_mode, bool is_primitive_restart_enabled, u32 primitive_restart_index)
 	{
@@ -1040,6 +1499,12 @@ namespace
 
 		ensure((dst.size() >= 3 * (src.size() - 2)));
 
+		if (s_use_sse4_1 && src.size() >= 32 &&
+			(!is_primitive_restart_enabled || !expand_impl::contains_restart_index<T>(src, primitive_restart_index)))
+		{
+			return expand_impl::expand_triangle_fan<T>(src, dst);
+		}
+
 		u32 dst_idx = 0;
 
 		bool needs_anchor = true;
@@ -1090,6 +1555,12 @@ namespace
 
 		ensure((4 * dst.size_bytes() >= 6 * src.size_bytes()));
 
+		if (s_use_sse4_1 && src.size() >= 32 &&
+			(!is_primitive_restart_enabled || !expand_impl::contains_restart_index<T>(src, primitive_restart_index)))
+		{
+			return expand_impl::expand_quads<T>(src, dst);
+		}
+
 		u32 dst_idx = 0;
 		u8 set_size = 0;
 		T tmp_indices[4];
@@ -1197,24 +1668,78 @@ u32 get_index_type_size(rsx::index_array_type type)
 void write_index_array_for_non_indexed_non_native_primitive_to_buffer(char* dst, rsx::primitive_type draw_mode, unsigned count)
 {
 	auto typedDst = reinterpret_cast<u16*>(dst);
+	auto dst_stream = reinterpret_cast<__m128i*>(dst);
+
 	switch (draw_mode)
 	{
 	case rsx::primitive_type::line_loop:
-		for (unsigned i = 0; i < count; ++i)
+	{
+		// 8 consecutive indices per vector
+		const __m128i step = _mm_set1_epi16(8);
+		__m128i value = _mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7);
+
+		unsigned i = 0;
+		for (; (i + 8) <= count; i += 8)
+		{
+			_mm_storeu_si128(dst_stream++, value);
+			value = _mm_add_epi16(value, step);
+		}
+
+		for (; i < count; ++i)
 			typedDst[i] = i;
 		typedDst[count] = 0;
 		return;
+	}
 	case rsx::primitive_type::triangle_fan:
 	case rsx::primitive_type::polygon:
-		for (unsigned i = 0; i < (count - 2); i++)
+	{
+		// 8 triangles (24 indices) per 3 vectors. The anchor lanes are never incremented.
+		__m128i value0 = _mm_setr_epi16(0, 1, 2, 0, 2, 3, 0, 3);
+		__m128i value1 = _mm_setr_epi16(4, 0, 4, 5, 0, 5, 6, 0);
+		__m128i value2 = _mm_setr_epi16(6, 7, 0, 7, 8, 0, 8, 9);
+		const __m128i step0 = _mm_setr_epi16(0, 8, 8, 0, 8, 8, 0, 8);
+		const __m128i step1 = _mm_setr_epi16(8, 0, 8, 8, 0, 8, 8, 0);
+		const __m128i step2 = _mm_setr_epi16(8, 8, 0, 8, 8, 0, 8, 8);
+
+		unsigned i = 0;
+		for (; (i + 8) <= (count - 2); i += 8)
+		{
+			_mm_storeu_si128(dst_stream++, value0);
+			_mm_storeu_si128(dst_stream++, value1);
+			_mm_storeu_si128(dst_stream++, value2);
+			value0 = _mm_add_epi16(value0, step0);
+			value1 = _mm_add_epi16(value1, step1);
+			value2 = _mm_add_epi16(value2, step2);
+		}
+
+		for (; i < (count - 2); i++)
 		{
 			typedDst[3 * i] = 0;
 			typedDst[3 * i + 1] = i + 2 - 1;
 			typedDst[3 * i + 2] = i + 2;
 		}
 		return;
+	}
 	case rsx::primitive_type::quads:
-		for (unsigned i = 0; i < count / 4; i++)
+	{
+		// 4 quads (24 indices) per 3 vectors
+		__m128i value0 = _mm_setr_epi16(0, 1, 2, 2, 3, 0, 4, 5);
+		__m128i value1 = _mm_setr_epi16(6, 6, 7, 4, 8, 9, 10, 10);
+		__m128i value2 = _mm_setr_epi16(11, 8, 12, 13, 14, 14, 15, 12);
+		const __m128i step = _mm_set1_epi16(16);
+
+		unsigned i = 0;
+		for (; (i + 4) <= (count / 4); i += 4)
+		{
+			_mm_storeu_si128(dst_stream++, value0);
+			_mm_storeu_si128(dst_stream++, value1);
+			_mm_storeu_si128(dst_stream++, value2);
+			value0 = _mm_add_epi16(value0, step);
+			value1 = _mm_add_epi16(value1, step);
+			value2 = _mm_add_epi16(value2, step);
+		}
+
+		for (; i < count / 4; i++)
 		{
 			// First triangle
 			typedDst[6 * i] = 4 * i;
@@ -1226,6 +1751,7 @@ void write_index_array_for_non_indexed_non_native_primitive_to_buffer(char* dst,
 			typedDst[6 * i + 5] = 4 * i;
 		}
 		return;
+	}
 	case rsx::primitive_type::quad_strip:
 	case rsx::primitive_type::points:
 	case rsx::primitive_type::lines:
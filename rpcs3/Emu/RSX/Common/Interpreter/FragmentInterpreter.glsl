@@ -207,10 +207,18 @@ vec4 read_src(const in int index)
 		{
 		case 0:
 			vr0 = wpos; break;
+#ifdef WITH_TWO_SIDED_LIGHTING
 		case 1:
 			vr0 = gl_FrontFacing? in_regs[3] : in_regs[1]; break;
 		case 2:
 			vr0 = gl_FrontFacing? in_regs[4] : in_regs[2]; break;
+#else
+		// Front and back colors are identical when two-sided lighting is disabled
+		case 1:
+			vr0 = in_regs[1]; break;
+		case 2:
+			vr0 = in_regs[2]; break;
+#endif
 		case 3:
 			vr0 = fogc; break;
 		case 13:
@@ -306,21 +314,40 @@ vec4 _texture(in vec4 coord, float bias)
 		return vr_zero;
 	}
 
+	coord.xy *= texture_parameters[ur0].scale;
+
+#if defined(WITH_SINGLE_TEXTURE_TYPE) && defined(WITH_TEXTURE_1D)
+	vr0 = texture(SAMPLER1D(ur0), coord.x, bias);
+#elif defined(WITH_SINGLE_TEXTURE_TYPE) && defined(WITH_TEXTURE_2D)
+	vr0 = texture(SAMPLER2D(ur0), coord.xy, bias);
+#elif defined(WITH_SINGLE_TEXTURE_TYPE) && defined(WITH_TEXTURE_CUBE)
+	vr0 = texture(SAMPLERCUBE(ur0), coord.xyz, bias);
+#elif defined(WITH_SINGLE_TEXTURE_TYPE) && defined(WITH_TEXTURE_3D)
+	vr0 = texture(SAMPLER3D(ur0), coord.xyz, bias);
+#else
 	ur1 = ur0 + ur0;
 	const uint type = bitfieldExtract(texture_control, int(ur1), 2);
-	coord.xy *= texture_parameters[ur0].scale;
 
 	switch (type)
 	{
+#ifdef WITH_TEXTURE_1D
 	case 0:
 		vr0 = texture(SAMPLER1D(ur0), coord.x, bias); break;
+#endif
+#ifdef WITH_TEXTURE_2D
 	case 1:
 		vr0 = texture(SAMPLER2D(ur0), coord.xy, bias); break;
+#endif
+#ifdef WITH_TEXTURE_CUBE
 	case 2:
 		vr0 = texture(SAMPLERCUBE(ur0), coord.xyz, bias); break;
+#endif
+#ifdef WITH_TEXTURE_3D
 	case 3:
 		vr0 = texture(SAMPLER3D(ur0), coord.xyz, bias); break;
+#endif
 	}
+#endif
 
 	if (TEST_BIT(0, 21))
 	{
@@ -338,21 +365,40 @@ vec4 _textureLod(in vec4 coord, float lod)
 		return vr_zero;
 	}
 
+	coord.xy *= texture_parameters[ur0].scale;
+
+#if defined(WITH_SINGLE_TEXTURE_TYPE) && defined(WITH_TEXTURE_1D)
+	vr0 = textureLod(SAMPLER1D(ur0), coord.x, lod);
+#elif defined(WITH_SINGLE_TEXTURE_TYPE) && defined(WITH_TEXTURE_2D)
+	vr0 = textureLod(SAMPLER2D(ur0), coord.xy, lod);
+#elif defined(WITH_SINGLE_TEXTURE_TYPE) && defined(WITH_TEXTURE_CUBE)
+	vr0 = textureLod(SAMPLERCUBE(ur0), coord.xyz, lod);
+#elif defined(WITH_SINGLE_TEXTURE_TYPE) && defined(WITH_TEXTURE_3D)
+	vr0 = textureLod(SAMPLER3D(ur0), coord.xyz, lod);
+#else
 	ur1 = ur0 + ur0;
 	const uint type = bitfieldExtract(texture_control, int(ur1), 2);
-	coord.xy *= texture_parameters[ur0].scale;
 
 	switch (type)
 	{
+#ifdef WITH_TEXTURE_1D
 	case 0:
 		vr0 = textureLod(SAMPLER1D(ur0), coord.x, lod); break;
+#endif
+#ifdef WITH_TEXTURE_2D
 	case 1:
 		vr0 = textureLod(SAMPLER2D(ur0), coord.xy, lod); break;
+#endif
+#ifdef WITH_TEXTURE_CUBE
 	case 2:
 		vr0 = textureLod(SAMPLERCUBE(ur0), coord.xyz, lod); break;
+#endif
+#ifdef WITH_TEXTURE_3D
 	case 3:
 		vr0 = textureLod(SAMPLER3D(ur0), coord.xyz, lod); break;
+#endif
 	}
+#endif
 
 	if (TEST_BIT(0, 21))
 	{
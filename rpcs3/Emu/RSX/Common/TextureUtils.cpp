@@ -1,10 +1,12 @@
 #include "stdafx.h"
 #include "Emu/Memory/vm.h"
+#include "Emu/system_config.h"
 #include "TextureUtils.h"
 #include "../RSXThread.h"
 #include "../rsx_utils.h"
 
 #include "util/asm.hpp"
+#include "util/sysinfo.hpp"
 
 namespace utils
 {
@@ -18,6 +20,122 @@ namespace utils
 namespace
 {
 
+// Splits large texture decode jobs into row ranges and processes them on a small pool of workers.
+// The submitting thread works on the same job and only returns once every range has been decoded.
+class texture_decode_pool
+{
+	struct decode_job
+	{
+		const std::function<void(u32, u32)>& func;
+		const u32 count;
+		const u32 granularity;
+
+		atomic_t<u32> next = 0;
+		atomic_t<u32> pending_workers = 0;
+
+		void execute()
+		{
+			for (u32 begin = next.fetch_add(granularity); begin < count; begin = next.fetch_add(granularity))
+			{
+				func(begin, std::min(begin + granularity, count));
+			}
+		}
+	};
+
+	struct decode_thread
+	{
+		lf_queue<decode_job*> m_work_queue;
+
+		void operator()()
+		{
+			while (thread_ctrl::state() != thread_state::aborting)
+			{
+				for (auto&& job : m_work_queue.pop_all())
+				{
+					job->execute();
+					job->pending_workers--;
+				}
+
+				thread_ctrl::wait_on(m_work_queue, nullptr);
+			}
+		}
+	};
+
+	std::unique_ptr<named_thread_group<decode_thread>> m_workers;
+	u32 m_worker_count = 0;
+
+public:
+	texture_decode_pool()
+	{
+		u32 thread_count = g_cfg.video.texture_decoder_threads_count;
+
+		if (thread_count == 0)
+		{
+			// Leave most of the host to the PPU/SPU threads
+			const auto hw_threads = utils::get_thread_count();
+			thread_count = hw_threads >= 12 ? 4 : (hw_threads >= 8 ? 2 : 1);
+		}
+
+		// The calling thread always participates
+		if (m_worker_count = thread_count - 1; m_worker_count)
+		{
+			m_workers = std::make_unique<named_thread_group<decode_thread>>("RSX Texture Decoder", m_worker_count);
+		}
+	}
+
+	texture_decode_pool(const texture_decode_pool&) = delete;
+
+	texture_decode_pool& operator=(const texture_decode_pool&) = delete;
+
+	// Runs func(begin, end) over [0, count). Work is only distributed if each item is at least bytes_per_item large in total.
+	void run(u32 count, u32 bytes_per_item, u32 alignment, const std::function<void(u32, u32)>& func)
+	{
+		// Do not bother with small uploads, the dispatch overhead is larger than the copy
+		constexpr u32 min_parallel_size = 256 * 1024;
+		constexpr u32 target_chunk_size = 64 * 1024;
+
+		const u64 total_size = u64{count} * bytes_per_item;
+
+		if (!m_worker_count || total_size < min_parallel_size)
+		{
+			func(0, count);
+			return;
+		}
+
+		const u32 granularity = utils::align(std::max(target_chunk_size / std::max(bytes_per_item, 1u), 1u), alignment);
+
+		decode_job job{ func, count, granularity };
+		job.pending_workers = m_worker_count;
+
+		for (decode_thread& worker : *m_workers)
+		{
+			worker.m_work_queue.push(&job);
+		}
+
+		job.execute();
+
+		// Memory faults raised by the workers may need the RSX thread to flush surfaces before they can proceed
+		const auto rsxthr = rsx::get_current_renderer();
+		const bool is_rsx_thread = rsxthr && rsxthr->is_current_thread();
+
+		while (job.pending_workers.load())
+		{
+			if (is_rsx_thread)
+			{
+				rsxthr->on_semaphore_acquire_wait();
+			}
+
+			utils::pause();
+		}
+	}
+};
+
+template <typename F>
+void parallel_decode(u32 count, u32 bytes_per_item, u32 alignment, F&& func)
+{
+	g_fxo->get<texture_decode_pool>().run(count, bytes_per_item, alignment, std::forward<F>(func));
+}
+
 u16 convert_rgb655_to_rgb565(const u16 bits)
 {
 	// g6 = g5
@@ -35,8 +153,17 @@ struct copy_unmodified_block
 		if (src_pitch_in_block == dst_pitch_in_block && !border)
 		{
 			// Fast copy
-			const auto data_length = src_pitch_in_block * words_per_block * row_count * depth;
-			std::copy_n(src.begin(), std::min<usz>({data_length, src.size(), dst.size()}), dst.begin());
+			const u32 data_length = static_cast<u32>(std::min<usz>({src_pitch_in_block * words_per_block * row_count * depth, src.size(), dst.size()}));
+			const u32 row_length = std::max(src_pitch_in_block * words_per_block, 1u);
+			const u32 rows = data_length / row_length;
+
+			parallel_decode(rows, row_length * sizeof(T), 1, [&](u32 first_row, u32 last_row)
+			{
+				// The last range also picks up any partial row at the end
+				const u32 begin = first_row * row_length;
+				const u32 end = (last_row == rows) ? data_length : last_row * row_length;
+				std::copy_n(src.begin() + begin, end - begin, dst.begin() + begin);
+			});
 			return;
 		}
 
@@ -46,28 +173,44 @@ struct copy_unmodified_block
 
 		const u32 h_porch = border * words_per_block;
 		const u32 v_porch = src_pitch_in_words * border;
-		u32 src_offset = h_porch, dst_offset = 0;
+		const u32 src_layer_length = (v_porch * 2) + (src_pitch_in_words * row_count);
 
-		for (int layer = 0; layer < depth; ++layer)
+		// Rows are independent, so the whole level is processed as a flat list of rows
+		parallel_decode(u32{row_count} * depth, width_in_words * sizeof(T), 1, [&](u32 first_row, u32 last_row)
 		{
-			// Front
-			src_offset += v_porch;
-
-			for (int row = 0; row < row_count; ++row)
+			for (u32 i = first_row; i < last_row; ++i)
 			{
-				// NOTE: src_offset is already shifted along the border at initialization
-				std::copy_n(src.begin() + src_offset, width_in_words, dst.begin() + dst_offset);
+				const u32 layer = i / row_count;
+				const u32 row = i % row_count;
 
-				src_offset += src_pitch_in_words;
-				dst_offset += dst_pitch_in_words;
+				// NOTE: Source rows are shifted along the border on both axes
+				const u32 src_offset = h_porch + (layer * src_layer_length) + v_porch + (row * src_pitch_in_words);
+				std::copy_n(src.begin() + src_offset, width_in_words, dst.begin() + (i * dst_pitch_in_words));
 			}
-
-			// Back
-			src_offset += v_porch;
-		}
+		});
 	}
 };
 
+template <typename T>
+void convert_linear_swizzle_3d_parallel(const void* input_pixels, void* output_pixels, u16 width, u16 height, u16 depth)
+{
+	if (depth == 1)
+	{
+		// Split by row pairs, the deswizzle walks 2x2 quads
+		parallel_decode(height, width * sizeof(T), 2, [&](u32 first_row, u32 last_row)
+		{
+			rsx::convert_linear_swizzle<T, true>(input_pixels, output_pixels, width, height, width * sizeof(T), static_cast<u16>(first_row), static_cast<u16>(last_row));
+		});
+	}
+	else
+	{
+		parallel_decode(depth, u32{width} * height * sizeof(T), 1, [&](u32 first_slice, u32 last_slice)
+		{
+			rsx::convert_linear_swizzle_3d<T>(input_pixels, output_pixels, width, height, depth, static_cast<u16>(first_slice), static_cast<u16>(last_slice));
+		});
+	}
+}
+
 struct copy_unmodified_block_swizzled
 {
 	// NOTE: Pixel channel types are T (out) and const U (in). V is the pixel block type that consumes one whole pixel.
@@ -77,7 +220,7 @@ struct copy_unmodified_block_swizzled
 	{
 		if (std::is_same<T, U>::value && dst_pitch_in_block == width_in_block && words_per_block == 1 && !border)
 		{
-			rsx::convert_linear_swizzle_3d<T>(src.data(), dst.data(), width_in_block, row_count, depth);
+			convert_linear_swizzle_3d_parallel<T>(src.data(), dst.data(), width_in_block, row_count, depth);
 		}
 		else
 		{
@@ -98,20 +241,20 @@ struct copy_unmodified_block_swizzled
 
 			if (words_per_block == 1) [[likely]]
 			{
-				rsx::convert_linear_swizzle_3d<T>(src.data(), tmp.data(), padded_width, padded_height, depth);
+				convert_linear_swizzle_3d_parallel<T>(src.data(), tmp.data(), padded_width, padded_height, depth);
 			}
 			else
 			{
 				switch (words_per_block * sizeof(T))
 				{
 				case 4:
-					rsx::convert_linear_swizzle_3d<u32>(src.data(), tmp.data(), padded_width, padded_height, depth);
+					convert_linear_swizzle_3d_parallel<u32>(src.data(), tmp.data(), padded_width, padded_height, depth);
 					break;
 				case 8:
-					rsx::convert_linear_swizzle_3d<u64>(src.data(), tmp.data(), padded_width, padded_height, depth);
+					convert_linear_swizzle_3d_parallel<u64>(src.data(), tmp.data(), padded_width, padded_height, depth);
 					break;
 				case 16:
-					rsx::convert_linear_swizzle_3d<u128>(src.data(), tmp.data(), padded_width, padded_height, depth);
+					convert_linear_swizzle_3d_parallel<u128>(src.data(), tmp.data(), padded_width, padded_height, depth);
 					break;
 				default:
 					fmt::throw_exception("Failed to decode swizzled format, words_per_block=%d, src_type_size=%d", words_per_block, sizeof(T));
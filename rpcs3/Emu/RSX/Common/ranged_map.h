@@ -0,0 +1,293 @@
+#pragma once
+
+#include "util/types.hpp"
+#include "Utilities/address_range.h"
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <unordered_map>
+
+namespace rsx
+{
+	/**
+	 * Map of address -> resource, bucketed by fixed-size memory blocks.
+	 * Every entry lives in the block containing its key. Each block also remembers the lowest block
+	 * holding an entry that extends into it, so overlap queries only visit the blocks that can
+	 * possibly intersect the requested range instead of the whole map.
+	 * The stored type must expose get_memory_range() through operator->.
+	 */
+	template <typename T, u32 BlockSize = 0x100000>
+	class ranged_map
+	{
+		static_assert(BlockSize && (BlockSize & (BlockSize - 1)) == 0, "Block size must be a power of 2");
+
+		static constexpr u32 block_count = static_cast<u32>(0x1'0000'0000ull / BlockSize);
+
+		using inner_type = std::unordered_map<u32, T>;
+
+		struct block_metadata
+		{
+			u32 head_block = umax; // Lowest block with an entry spanning into this one
+		};
+
+		std::unique_ptr<std::array<inner_type, block_count>> m_data = std::make_unique<std::array<inner_type, block_count>>();
+		std::unique_ptr<std::array<block_metadata, block_count>> m_metadata = std::make_unique<std::array<block_metadata, block_count>>();
+
+		u32 m_size = 0;
+
+		// Range of blocks that have ever held an entry, for cheap full iteration
+		u32 m_first_used_block = umax;
+		u32 m_last_used_block = 0;
+
+		static constexpr u32 block_for(u32 address)
+		{
+			return address / BlockSize;
+		}
+
+	public:
+		class iterator
+		{
+			friend class ranged_map;
+
+			ranged_map* m_map = nullptr;
+			u32 m_block = 0;
+			u32 m_end_block = 0;
+			typename inner_type::iterator m_it{};
+
+			void next_block()
+			{
+				while (m_block < m_end_block)
+				{
+					if (++m_block == m_end_block)
+					{
+						break;
+					}
+
+					if (auto& block = (*m_map->m_data)[m_block]; !block.empty())
+					{
+						m_it = block.begin();
+						return;
+					}
+				}
+
+				m_it = {};
+			}
+
+			void settle()
+			{
+				if (m_block == m_end_block)
+				{
+					return;
+				}
+
+				if (m_it == (*m_map->m_data)[m_block].end())
+				{
+					next_block();
+				}
+			}
+
+		public:
+			using value_type = typename inner_type::value_type;
+
+			iterator() = default;
+
+			iterator(ranged_map* map, u32 first_block, u32 end_block)
+				: m_map(map), m_block(first_block), m_end_block(end_block)
+			{
+				if (m_block < m_end_block)
+				{
+					m_it = (*m_map->m_data)[m_block].begin();
+					settle();
+				}
+			}
+
+			iterator(ranged_map* map, u32 block, u32 end_block, typename inner_type::iterator it)
+				: m_map(map), m_block(block), m_end_block(end_block), m_it(it)
+			{
+			}
+
+			value_type& operator*() const { return *m_it; }
+			value_type* operator->() const { return &*m_it; }
+
+			iterator& operator++()
+			{
+				++m_it;
+				settle();
+				return *this;
+			}
+
+			bool operator==(const iterator& other) const
+			{
+				if (m_block == m_end_block || other.m_block == other.m_end_block)
+				{
+					return (m_block == m_end_block) == (other.m_block == other.m_end_block);
+				}
+
+				return m_block == other.m_block && m_it == other.m_it;
+			}
+		};
+
+		// Iterable view over the entries that may overlap a range. Callers still test the actual overlap
+		class range_view
+		{
+			ranged_map* m_map;
+			u32 m_first_block;
+			u32 m_end_block;
+
+		public:
+			range_view(ranged_map* map, u32 first_block, u32 end_block)
+				: m_map(map), m_first_block(first_block), m_end_block(end_block)
+			{
+			}
+
+			iterator begin() const { return { m_map, m_first_block, m_end_block }; }
+			iterator end() const { return { m_map, m_end_block, m_end_block }; }
+		};
+
+		ranged_map() = default;
+		ranged_map(const ranged_map&) = delete;
+		ranged_map& operator=(const ranged_map&) = delete;
+
+		iterator begin()
+		{
+			if (!m_size)
+			{
+				return end();
+			}
+
+			return { this, m_first_used_block, m_last_used_block + 1 };
+		}
+
+		iterator end()
+		{
+			const u32 end_block = m_size ? m_last_used_block + 1 : 0;
+			return { this, end_block, end_block };
+		}
+
+		range_view range(const utils::address_range& range)
+		{
+			if (!m_size || !range.valid())
+			{
+				return { this, 0, 0 };
+			}
+
+			const u32 start_block = block_for(range.start);
+			const u32 last_block = std::min(block_for(range.end), m_last_used_block);
+			const u32 first_block = std::max(std::min(start_block, (*m_metadata)[start_block].head_block), m_first_used_block);
+
+			if (first_block > last_block)
+			{
+				return { this, 0, 0 };
+			}
+
+			return { this, first_block, last_block + 1 };
+		}
+
+		iterator find(u32 key)
+		{
+			const u32 block_id = block_for(key);
+			auto& block = (*m_data)[block_id];
+
+			if (auto found = block.find(key); found != block.end())
+			{
+				return { this, block_id, m_last_used_block + 1, found };
+			}
+
+			return end();
+		}
+
+		// Inserts or replaces the entry at key and indexes the memory it covers
+		T& emplace(u32 key, T&& value)
+		{
+			const u32 block_id = block_for(key);
+			auto& block = (*m_data)[block_id];
+			auto [it, inserted] = block.insert_or_assign(key, std::move(value));
+
+			if (inserted)
+			{
+				m_size++;
+				m_first_used_block = std::min(m_first_used_block, block_id);
+				m_last_used_block = std::max(m_last_used_block, block_id);
+			}
+
+			index_range(it->second->get_memory_range());
+			return it->second;
+		}
+
+		// Must be called when a stored entry grows in place (e.g. a pitch change on a reused surface)
+		void index_range(const utils::address_range& range)
+		{
+			if (!range.valid())
+			{
+				return;
+			}
+
+			const u32 start_block = block_for(range.start);
+			const u32 last_block = block_for(range.end);
+
+			for (u32 block_id = start_block + 1; block_id <= last_block; ++block_id)
+			{
+				auto& head = (*m_metadata)[block_id].head_block;
+				head = std::min(head, start_block);
+			}
+		}
+
+		// Lookup of an entry known to exist
+		T& operator[](u32 key)
+		{
+			auto& block = (*m_data)[block_for(key)];
+			const auto found = block.find(key);
+			ensure(found != block.end());
+			return found->second;
+		}
+
+		iterator erase(iterator it)
+		{
+			auto& block = (*m_data)[it.m_block];
+			iterator next{ this, it.m_block, it.m_end_block, block.erase(it.m_it) };
+			next.settle();
+
+			m_size--;
+			return next;
+		}
+
+		usz erase(u32 key)
+		{
+			if ((*m_data)[block_for(key)].erase(key))
+			{
+				m_size--;
+				return 1;
+			}
+
+			return 0;
+		}
+
+		void clear()
+		{
+			if (m_size)
+			{
+				for (u32 block_id = m_first_used_block; block_id <= m_last_used_block; ++block_id)
+				{
+					(*m_data)[block_id].clear();
+				}
+			}
+
+			// Span metadata is conservative and only reset once nothing references it
+			m_metadata->fill({});
+			m_size = 0;
+			m_first_used_block = umax;
+			m_last_used_block = 0;
+		}
+
+		u32 size() const
+		{
+			return m_size;
+		}
+
+		bool empty() const
+		{
+			return m_size == 0;
+		}
+	};
+}
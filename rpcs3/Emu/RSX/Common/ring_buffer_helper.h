@@ -57,6 +57,10 @@ protected:
 	usz m_min_guard_size; //If an allocation touches the guard region, reset the heap to avoid going over budget
 	usz m_current_allocated_size;
 	usz m_largest_allocated_pool;
+	usz m_peak_allocated_size = 0; // Occupancy high-water mark, survives heap resizes
+
+	// Absolute position of the heap base. Advances by the heap size on every wrap and by more than that whenever contents are discarded.
+	u64 m_allocation_base = 0;
 
 	char* m_name;
 public:
@@ -71,6 +75,9 @@ public:
 	{
 		m_name = const_cast<char*>(buffer_name);
 
+		// Previous contents (if any) are lost, push the marker beyond a full heap cycle
+		m_allocation_base += 2 * heap_size + 1;
+
 		m_size = heap_size;
 		m_put_pos = 0;
 		m_get_pos = heap_size - 1;
@@ -96,6 +103,7 @@ public:
 		const usz block_length = (aligned_put_pos - m_put_pos) + alloc_size;
 		m_current_allocated_size += block_length;
 		m_largest_allocated_pool = std::max(m_largest_allocated_pool, block_length);
+		m_peak_allocated_size = std::max(m_peak_allocated_size, m_current_allocated_size);
 
 		if (aligned_put_pos + alloc_size < m_size)
 		{
@@ -104,11 +112,20 @@ public:
 		}
 		else
 		{
+			m_allocation_base += m_size;
 			m_put_pos = alloc_size;
 			return 0;
 		}
 	}
 
+	/**
+	* Monotonic allocation position. A block allocated after marker M has not been overwritten while (current marker - M) <= size()
+	*/
+	u64 get_allocation_marker() const
+	{
+		return m_allocation_base + m_put_pos;
+	}
+
 	/**
 	* return current putpos - 1
 	*/
@@ -147,4 +164,9 @@ public:
 	{
 		return m_size;
 	}
+
+	usz get_peak_usage() const
+	{
+		return m_peak_allocated_size;
+	}
 };
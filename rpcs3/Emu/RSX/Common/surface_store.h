@@ -1,6 +1,7 @@
 #pragma once
 
 #include "surface_utils.h"
+#include "ranged_map.h"
 #include "../gcm_enums.h"
 #include "../rsx_utils.h"
 #include <list>
@@ -43,10 +44,11 @@ namespace rsx
 		using surface_type = typename Traits::surface_type;
 		using command_list_type = typename Traits::command_list_type;
 		using surface_overlap_info = surface_overlap_info_t<surface_type>;
+		using surface_ranged_map = ranged_map<surface_storage_type>;
 
 	protected:
-		std::unordered_map<u32, surface_storage_type> m_render_targets_storage = {};
-		std::unordered_map<u32, surface_storage_type> m_depth_stencil_storage = {};
+		surface_ranged_map m_render_targets_storage = {};
+		surface_ranged_map m_depth_stencil_storage = {};
 
 		rsx::address_range m_render_targets_memory_range;
 		rsx::address_range m_depth_stencil_memory_range;
@@ -86,7 +88,7 @@ namespace rsx
 			auto insert_new_surface = [&](
 				u32 new_address,
 				deferred_clipped_region<surface_type>& region,
-				std::unordered_map<u32, surface_storage_type>& data)
+				surface_ranged_map& data)
 			{
 				surface_storage_type sink;
 				surface_type invalidated = 0;
@@ -152,7 +154,7 @@ namespace rsx
 
 				ensure(region.target == Traits::get(sink));
 				orphaned_surfaces.push_back(region.target);
-				data[new_address] = std::move(sink);
+				data.emplace(new_address, std::move(sink));
 			};
 
 			// Define incoming region
@@ -240,10 +242,10 @@ namespace rsx
 		void intersect_surface_region(command_list_type cmd, u32 address, surface_type new_surface, surface_type prev_surface)
 		{
 			auto scan_list = [&new_surface, address](const rsx::address_range& mem_range,
-				std::unordered_map<u32, surface_storage_type>& data) -> std::vector<std::pair<u32, surface_type>>
+				surface_ranged_map& data) -> std::vector<std::pair<u32, surface_type>>
 			{
 				std::vector<std::pair<u32, surface_type>> result;
-				for (const auto &e : data)
+				for (const auto &e : data.range(mem_range))
 				{
 					auto surface = Traits::get(e.second);
 
@@ -403,7 +405,7 @@ namespace rsx
 			bool store = true;
 
 			address_range *storage_bounds;
-			std::unordered_map<u32, surface_storage_type> *primary_storage, *secondary_storage;
+			surface_ranged_map *primary_storage, *secondary_storage;
 			if constexpr (depth)
 			{
 				primary_storage = &m_depth_stencil_storage;
@@ -427,10 +429,17 @@ namespace rsx
 				if (Traits::surface_matches_properties(surface, format, width, height, antialias))
 				{
 					if (pitch_compatible)
+					{
 						Traits::notify_surface_persist(surface);
+					}
 					else
+					{
 						Traits::invalidate_surface_contents(command_list, Traits::get(surface), address, pitch);
 
+						// The new pitch can make the surface span more memory
+						primary_storage->index_range(surface->get_memory_range());
+					}
+
 					Traits::prepare_surface_for_drawing(command_list, Traits::get(surface));
 					new_surface = Traits::get(surface);
 					store = false;
@@ -554,7 +563,7 @@ namespace rsx
 			if (store)
 			{
 				// New surface was found among invalidated surfaces or created from scratch
-				(*primary_storage)[address] = std::move(new_surface_storage);
+				primary_storage->emplace(address, std::move(new_surface_storage));
 			}
 
 			ensure(!old_surface_storage);
@@ -789,9 +798,9 @@ namespace rsx
 
 			const auto test_range = utils::address_range::start_length(texaddr, (required_pitch * required_height) - (required_pitch - surface_internal_pitch));
 
-			auto process_list_function = [&](std::unordered_map<u32, surface_storage_type>& data, bool is_depth)
+			auto process_list_function = [&](surface_ranged_map& data, bool is_depth)
 			{
-				for (auto& tex_info : data)
+				for (auto& tex_info : data.range(test_range))
 				{
 					const auto range = tex_info.second->get_memory_range();
 					if (!range.overlaps(test_range))
@@ -1050,7 +1059,7 @@ namespace rsx
 
 		void invalidate_range(const rsx::address_range& range)
 		{
-			for (auto &rtt : m_render_targets_storage)
+			for (auto &rtt : m_render_targets_storage.range(range))
 			{
 				if (range.overlaps(rtt.second->get_memory_range()))
 				{
@@ -1059,7 +1068,7 @@ namespace rsx
 				}
 			}
 
-			for (auto &ds : m_depth_stencil_storage)
+			for (auto &ds : m_depth_stencil_storage.range(range))
 			{
 				if (range.overlaps(ds.second->get_memory_range()))
 				{
@@ -1084,7 +1093,7 @@ namespace rsx
 
 		bool handle_memory_pressure(command_list_type cmd, problem_severity /*severity*/)
 		{
-			auto process_list_function = [&](std::unordered_map<u32, surface_storage_type>& data)
+			auto process_list_function = [&](surface_ranged_map& data)
 			{
 				for (auto It = data.begin(); It != data.end();)
 				{
@@ -329,14 +329,18 @@ namespace rsx
 
 		//Memory usage
 		const u32 m_max_zombie_objects = 64; //Limit on how many texture objects to keep around for reuse after they are invalidated
+		u64 m_frame_id = 1; // Timestamp used for the section access history
+		u32 m_evictions_last_frame = 0; // Sections evicted by the budget at the last frame boundary
 
 		//Other statistics
 		atomic_t<u32> m_flushes_this_frame = { 0 };
 		atomic_t<u32> m_misses_this_frame  = { 0 };
 		atomic_t<u32> m_speculations_this_frame = { 0 };
+		atomic_t<u32> m_async_flushes_this_frame = { 0 };
 		atomic_t<u32> m_unavoidable_hard_faults_this_frame = { 0 };
 		atomic_t<u32> m_texture_upload_calls_this_frame = { 0 };
 		atomic_t<u32> m_texture_upload_misses_this_frame = { 0 };
+		atomic_t<u32> m_texture_upload_skips_this_frame = { 0 };
 		static const u32 m_predict_max_flushes_per_frame = 50; // Above this number the predictions are disabled
 
 		// Invalidation
@@ -1009,9 +1013,121 @@ namespace rsx
 
 		virtual void on_frame_end()
 		{
-			m_temporary_subresource_cache.clear();
-			m_predictor.on_frame_end();
-			reset_frame_statistics();
+			{
+				// Faulting threads may update the predictor through try_flush_all_async
+				std::lock_guard lock(m_cache_mutex);
+
+				m_temporary_subresource_cache.clear();
+				m_predictor.on_frame_end();
+				reset_frame_statistics();
+			}
+
+			enforce_memory_budget();
+			m_frame_id++;
+		}
+
+		/**
+		 * Keeps resident texture memory under the configured budget.
+		 * Dirty sections are dropped first, then clean read-only sections in LRU-2 order (oldest second-to-last reference first).
+		 * Flushable sections and anything referenced this frame are never evicted.
+		 */
+		void enforce_memory_budget()
+		{
+			// Statistics for the previous boundary have been presented by now
+			m_evictions_last_frame = 0;
+
+			const u64 budget = u64{g_cfg.video.texture_cache_memory_budget} * 0x100000;
+			if (!budget || m_storage.m_texture_memory_in_use <= budget)
+			{
+				return;
+			}
+
+			std::lock_guard lock(m_cache_mutex);
+
+			if (m_storage.m_unreleased_texture_objects)
+			{
+				m_storage.purge_unreleased_sections();
+
+				if (m_storage.m_texture_memory_in_use <= budget)
+				{
+					return;
+				}
+			}
+
+			std::vector<section_storage_type*> candidates;
+			m_storage.for_each_existing_section([&](section_storage_type& tex)
+			{
+				if (tex.get_last_access() == m_frame_id || tex.is_flushable())
+				{
+					return;
+				}
+
+				switch (tex.get_context())
+				{
+				case rsx::texture_upload_context::shader_read:
+				case rsx::texture_upload_context::blit_engine_src:
+					candidates.push_back(&tex);
+					break;
+				default:
+					break;
+				}
+			});
+
+			std::sort(candidates.begin(), candidates.end(), [](const section_storage_type* a, const section_storage_type* b)
+			{
+				if (a->get_penultimate_access() != b->get_penultimate_access())
+				{
+					return a->get_penultimate_access() < b->get_penultimate_access();
+				}
+
+				return a->get_last_access() < b->get_last_access();
+			});
+
+			const u64 memory_before = m_storage.m_texture_memory_in_use;
+
+			for (auto* tex : candidates)
+			{
+				if (m_storage.m_texture_memory_in_use <= budget)
+				{
+					break;
+				}
+
+				if (tex->is_locked())
+				{
+					// Unprotecting pages shared with another locked section would silently drop that section's protection
+					const auto& lock_range = tex->get_locked_range();
+					bool shared_pages = false;
+
+					for (auto It = m_storage.range_begin(lock_range, section_bounds::locked_range, true); It != m_storage.range_end(); It++)
+					{
+						if (&(*It) != tex)
+						{
+							shared_pages = true;
+							break;
+						}
+					}
+
+					if (shared_pages)
+					{
+						continue;
+					}
+
+					tex->unprotect();
+				}
+
+				tex->destroy();
+				m_evictions_last_frame++;
+			}
+
+			if (m_storage.m_texture_memory_in_use > budget)
+			{
+				rsx_log.warning("Texture cache is over its memory budget after evicting %u sections (%lluM in use, budget %lluM)",
+					m_evictions_last_frame, m_storage.m_texture_memory_in_use / 0x100000, budget / 0x100000);
+			}
+			else
+			{
+				rsx_log.trace("Texture cache evicted %u sections, %lluM released", m_evictions_last_frame, (memory_before - m_storage.m_texture_memory_in_use) / 0x100000);
+			}
 		}
 
 		template <bool check_unlocked = false>
@@ -1379,6 +1495,54 @@ namespace rsx
 			return true;
 		}
 
+		/**
+		 * Flushes a deferred set from the faulting thread without a round trip through the RSX thread.
+		 * Only possible if every section already holds completed readback data (e.g. a speculative download issued earlier),
+		 * in which case the flush is a plain copy into guest memory. Returns false if the caller has to use flush_all.
+		 * Sets touching framebuffer storage are always rejected, syncing render targets modifies surface cache state owned by the RSX thread.
+		 */
+		template <typename ...Args>
+		bool try_flush_all_async(commandbuffer_type& cmd, thrashed_set& data, Args&&... extras)
+		{
+			std::lock_guard lock(m_cache_mutex);
+
+			AUDIT(data.cause.deferred_flush());
+			AUDIT(!data.flushed);
+
+			if (m_cache_update_tag.load() != data.cache_tag)
+			{
+				return false;
+			}
+
+			for (const auto& surface : data.sections_to_flush)
+			{
+				if (!surface->is_synchronized() || !surface->is_readback_complete() ||
+					surface->get_memory_read_flags() == rsx::memory_read_flags::flush_always ||
+					surface->get_context() == texture_upload_context::framebuffer_storage)
+				{
+					return false;
+				}
+			}
+
+			const auto is_framebuffer_section = [](const section_storage_type* section)
+			{
+				return section->get_context() == texture_upload_context::framebuffer_storage;
+			};
+
+			if (std::any_of(data.sections_to_exclude.begin(), data.sections_to_exclude.end(), is_framebuffer_section) ||
+				std::any_of(data.sections_to_unprotect.begin(), data.sections_to_unprotect.end(), is_framebuffer_section))
+			{
+				// The RSX thread has to be parked before render targets can be resynchronized or released
+				return false;
+			}
+
+			flush_set(cmd, data, std::forward<Args>(extras)...);
+			unprotect_set(data);
+
+			m_async_flushes_this_frame++;
+			return true;
+		}
+
 		template <typename ...Args>
 		bool flush_if_cache_miss_likely(commandbuffer_type& cmd, const address_range &range, Args&&... extras)
 		{
@@ -1610,6 +1774,7 @@ namespace rsx
 				// Most mesh textures are stored as compressed to make the most of the limited memory
 				if (auto cached_texture = find_texture_from_dimensions(attr.address, attr.gcm_format, attr.width, attr.height, attr.depth))
 				{
+					cached_texture->record_access(m_frame_id);
 					return{ cached_texture->get_view(encoded_remap, remap), cached_texture->get_context(), cached_texture->get_format_class(), scale, cached_texture->get_image_type() };
 				}
 			}
@@ -1702,6 +1867,7 @@ namespace rsx
 							return {};
 						}
 
+						cached_texture->record_access(m_frame_id);
 						return{ cached_texture->get_view(encoded_remap, remap), cached_texture->get_context(), cached_texture->get_format_class(), scale, cached_texture->get_image_type() };
 					}
 				}
@@ -2140,9 +2306,39 @@ namespace rsx
 			const address_range tex_range = address_range::start_length(attributes.address, tex_size);
 			invalidate_range_impl_base(cmd, tex_range, invalidation_cause::read, std::forward<Args>(extras)...);
 
+			u64 content_hash = 0;
+			if (g_cfg.video.texture_content_hashing)
+			{
+				// Memory is often rewritten with identical contents. If the previous image at this address still holds them, skip the upload.
+				content_hash = rsx::hash_guest_memory(tex_range.start, tex_range.length());
+
+				const image_section_attributes_t search_desc = { .gcm_format = attributes.gcm_format, .width = attributes.width, .height = attributes.height, .depth = attributes.depth, .mipmaps = tex.get_exact_mipmap_count() };
+				if (auto cached = find_cached_texture(tex_range, search_desc, false, true, true);
+					cached && cached->exists() && cached->is_dirty() && !cached->is_locked() &&
+					cached->content_hash == content_hash &&
+					cached->get_context() == texture_upload_context::shader_read &&
+					cached->get_image_type() == extended_dimension &&
+					cached->get_rsx_pitch() == attributes.pitch &&
+					cached->is_swizzled() == attributes.swizzled)
+				{
+					set_component_order(*cached, attributes.gcm_format, component_order::default_);
+
+					read_only_range = cached->get_min_max(read_only_range, rsx::section_bounds::locked_range);
+					cached->protect(utils::protection::ro);
+					cached->last_write_tag = rsx::get_shared_tag();
+					cached->record_access(m_frame_id);
+
+					m_texture_upload_skips_this_frame++;
+					return{ cached->get_view(tex.remap(), tex.decoded_remap()),
+							texture_upload_context::shader_read, format_class, scale, extended_dimension };
+				}
+			}
+
 			// Upload from CPU. Note that sRGB conversion is handled in the FS
 			auto uploaded = upload_image_from_cpu(cmd, tex_range, attributes.width, attributes.height, attributes.depth, tex.get_exact_mipmap_count(), attributes.pitch, attributes.gcm_format,
 				texture_upload_context::shader_read, subresources_layout, extended_dimension, attributes.swizzled);
+			uploaded->content_hash = content_hash;
+			uploaded->record_access(m_frame_id);
 
 			return{ uploaded->get_view(tex.remap(), tex.decoded_remap()),
 					texture_upload_context::shader_read, format_class, scale, extended_dimension };
@@ -2749,6 +2945,7 @@ namespace rsx
 					typeless_info.src_gcm_format = cached_src->get_gcm_format();
 				}
 
+				cached_src->record_access(m_frame_id);
 				vram_texture = cached_src->get_raw_texture();
 				typeless_info.src_context = cached_src->get_context();
 			}
@@ -2895,6 +3092,7 @@ namespace rsx
 
 				cached_dest->reprotect(utils::protection::no, { mem_offset, dst_payload_length });
 				cached_dest->touch(m_cache_update_tag);
+				cached_dest->record_access(m_frame_id);
 				update_cache_tag();
 
 				// Set swizzle flag
@@ -3071,9 +3269,11 @@ namespace rsx
 			m_flushes_this_frame.store(0u);
 			m_misses_this_frame.store(0u);
 			m_speculations_this_frame.store(0u);
+			m_async_flushes_this_frame.store(0u);
 			m_unavoidable_hard_faults_this_frame.store(0u);
 			m_texture_upload_calls_this_frame.store(0u);
 			m_texture_upload_misses_this_frame.store(0u);
+			m_texture_upload_skips_this_frame.store(0u);
 		}
 
 		void on_flush()
@@ -3111,6 +3311,17 @@ namespace rsx
 			return m_storage.m_texture_memory_in_use;
 		}
 
+		texture_cache_memory_usage get_texture_memory_usage()
+		{
+			reader_lock lock(m_cache_mutex);
+			return m_storage.get_memory_usage();
+		}
+
+		u32 get_num_evictions_last_frame() const
+		{
+			return m_evictions_last_frame;
+		}
+
 		u32 get_num_flush_requests() const
 		{
 			return m_flushes_this_frame;
@@ -3126,6 +3337,11 @@ namespace rsx
 			return m_speculations_this_frame;
 		}
 
+		u32 get_num_async_flushes() const
+		{
+			return m_async_flushes_this_frame;
+		}
+
 		u32 get_num_cache_misses() const
 		{
 			return m_misses_this_frame;
@@ -3152,6 +3368,11 @@ namespace rsx
 			return m_texture_upload_misses_this_frame;
 		}
 
+		u32 get_texture_upload_skips_this_frame() const
+		{
+			return m_texture_upload_skips_this_frame;
+		}
+
 		u32 get_texture_upload_miss_percentage() const
 		{
 			return (m_texture_upload_calls_this_frame)? (m_texture_upload_misses_this_frame * 100 / m_texture_upload_calls_this_frame) : 0;
@@ -115,4 +115,14 @@ namespace rsx
 		operator enum_type&() { return cause; }
 		constexpr operator enum_type() const { return cause; }
 	};
+
+	// Resident texture cache memory, split by what the sections are used for
+	struct texture_cache_memory_usage
+	{
+		u64 shader_read = 0;
+		u64 blit_engine_src = 0;
+		u64 blit_engine_dst = 0;
+		u64 framebuffer_storage = 0;
+		u64 unreleased = 0;
+	};
 }
@@ -224,6 +224,8 @@ namespace rsx
 
 		static constexpr u32 num_blocks = ranged_storage_type::num_blocks;
 		static constexpr u32 block_size = ranged_storage_type::block_size;
+		static constexpr u32 pages_per_block = block_size / 4096;
+		static_assert(pages_per_block % 64 == 0, "Page bitmap must fill whole words");
 
 		using unowned_container_type = std::unordered_set<section_storage_type*>;
 		using unowned_iterator = typename unowned_container_type::iterator;
@@ -239,6 +241,43 @@ namespace rsx
 		atomic_t<u32> unreleased_count = 0;
 		ranged_storage_type *m_storage = nullptr;
 
+		// Pages of this block touched by any valid section, owned or not. Lets range walks skip blocks without candidates
+		std::array<u64, pages_per_block / 64> m_page_bitmap = {};
+		std::unique_ptr<std::array<u32, pages_per_block>> m_page_refs; // Allocated on first use
+
+		template <bool add>
+		void update_page_refs(const address_range& section_range)
+		{
+			const u32 first_page = (std::max(section_range.start, range.start) - range.start) / 4096;
+			const u32 last_page = (std::min(section_range.end, range.end) - range.start) / 4096;
+
+			if (!m_page_refs)
+			{
+				ensure(add);
+				m_page_refs = std::make_unique<std::array<u32, pages_per_block>>();
+			}
+
+			auto& refs = *m_page_refs;
+			for (u32 page = first_page; page <= last_page; ++page)
+			{
+				if constexpr (add)
+				{
+					if (refs[page]++ == 0)
+					{
+						m_page_bitmap[page / 64] |= (1ull << (page % 64));
+					}
+				}
+				else
+				{
+					ensure(refs[page] > 0);
+					if (--refs[page] == 0)
+					{
+						m_page_bitmap[page / 64] &= ~(1ull << (page % 64));
+					}
+				}
+			}
+		}
+
 		inline void add_owned_section_overlaps(section_storage_type &section)
 		{
 			u32 end = section.get_section_range().end;
@@ -322,6 +361,9 @@ namespace rsx
 			AUDIT(unreleased_count == 0);
 			AUDIT(locked_count == 0);
 			sections.clear();
+
+			m_page_bitmap = {};
+			m_page_refs.reset();
 		}
 
 		inline bool is_first_block() const
@@ -354,6 +396,40 @@ namespace rsx
 		inline bool overlaps(const section_storage_type& section, section_bounds bounds = full_range) const { return section.overlaps(range, bounds); }
 		inline bool overlaps(const address_range& _range) const { return range.overlaps(_range); }
 
+		// Conservative test, false means no valid section in this block touches the range
+		bool may_contain(const address_range& _range) const
+		{
+			if (!range.overlaps(_range))
+			{
+				return false;
+			}
+
+			const u32 first_page = (std::max(_range.start, range.start) - range.start) / 4096;
+			const u32 last_page = (std::min(_range.end, range.end) - range.start) / 4096;
+
+			for (u32 word = first_page / 64; word <= last_page / 64; ++word)
+			{
+				u64 mask = ~0ull;
+
+				if (word == first_page / 64)
+				{
+					mask &= (~0ull << (first_page % 64));
+				}
+
+				if (word == last_page / 64)
+				{
+					mask &= (~0ull >> (63 - (last_page % 64)));
+				}
+
+				if (m_page_bitmap[word] & mask)
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
 		/**
 		 * Section callbacks
 		 */
@@ -376,6 +452,7 @@ namespace rsx
 		{
 			AUDIT(section.valid_range());
 			AUDIT(range.overlaps(section.get_section_base()));
+			update_page_refs<true>(section.get_section_range());
 			add_owned_section_overlaps(section);
 		}
 
@@ -383,6 +460,7 @@ namespace rsx
 		{
 			AUDIT(section.valid_range());
 			AUDIT(range.overlaps(section.get_section_base()));
+			update_page_refs<false>(section.get_section_range());
 			remove_owned_section_overlaps(section);
 		}
 
@@ -439,6 +517,7 @@ namespace rsx
 			AUDIT(section.get_section_base() < range.start);
 			AUDIT(!contains_unowned(section));
 			unowned.insert(&section);
+			update_page_refs<true>(section.get_section_range());
 		}
 
 		inline void remove_unowned_section(section_storage_type &section)
@@ -447,6 +526,7 @@ namespace rsx
 			AUDIT(section.get_section_base() < range.start);
 			AUDIT(contains_unowned(section));
 			unowned.erase(&section);
+			update_page_refs<false>(section.get_section_range());
 		}
 
 		inline unowned_iterator unowned_begin() { return unowned.begin(); }
@@ -630,6 +710,58 @@ namespace rsx
 			return any_released;
 		}
 
+		template <typename Func>
+		void for_each_existing_section(Func&& func)
+		{
+			for (auto* block : m_in_use)
+			{
+				if (block->get_exists_count() == 0)
+				{
+					continue;
+				}
+
+				for (auto& tex : *block)
+				{
+					if (tex.exists())
+					{
+						func(tex);
+					}
+				}
+			}
+		}
+
+		texture_cache_memory_usage get_memory_usage()
+		{
+			texture_cache_memory_usage result{};
+
+			for_each_existing_section([&](const section_storage_type& tex)
+			{
+				const u64 size = tex.get_section_size();
+
+				if (tex.is_unreleased())
+				{
+					result.unreleased += size;
+					return;
+				}
+
+				switch (tex.get_context())
+				{
+				case rsx::texture_upload_context::shader_read:
+					result.shader_read += size; break;
+				case rsx::texture_upload_context::blit_engine_src:
+					result.blit_engine_src += size; break;
+				case rsx::texture_upload_context::blit_engine_dst:
+					result.blit_engine_dst += size; break;
+				case rsx::texture_upload_context::framebuffer_storage:
+					result.framebuffer_storage += size; break;
+				default:
+					break;
+				}
+			});
+
+			return result;
+		}
+
 		void trim_sections()
 		{
 			for (auto it = m_in_use.begin(); it != m_in_use.end(); it++)
@@ -718,6 +850,13 @@ namespace rsx
 				, cur_block_it(block->begin())
 				, locked_only(_locked_only)
 			{
+				if (!block->may_contain(range))
+				{
+					// Nothing resident in the range on this block, owned or otherwise
+					unowned_remaining = false;
+					cur_block_it = block->end();
+				}
+
 				// do a "fake" iteration to ensure the internal state is consistent
 				next(false);
 			}
@@ -807,7 +946,7 @@ namespace rsx
 						needs_overlap_check = (block->get_end() > range.end);
 						cur_block_it = block->begin();
 						iterate = false;
-					} while (locked_only && block->get_locked_count() == 0); // find a block with locked sections
+					} while ((locked_only && block->get_locked_count() == 0) || !block->may_contain(range)); // find a block with candidate sections
 
 				} while (true);
 			}
@@ -1110,6 +1249,8 @@ namespace rsx
 
 		address_range_vector flush_exclusions; // Address ranges that will be skipped during flush
 
+		std::array<u64, 2> access_history = {}; // Frames of the two most recent reads, newest first
+
 		predictor_type *m_predictor = nullptr;
 		usz m_predictor_key_hash = 0;
 		predictor_entry_type *m_predictor_entry = nullptr;
@@ -1117,6 +1258,7 @@ namespace rsx
 	public:
 		u64 cache_tag = 0;
 		u64 last_write_tag = 0;
+		u64 content_hash = 0; // Hash of the guest memory contents at upload time, only tracked with texture content hashing enabled
 
 		~cached_texture_section()
 		{
@@ -1175,6 +1317,7 @@ namespace rsx
 
 			cache_tag = 0ull;
 			last_write_tag = 0ull;
+			content_hash = 0ull;
 
 			m_predictor_entry = nullptr;
 
@@ -1184,6 +1327,7 @@ namespace rsx
 			image_type = rsx::texture_dimension_extended::texture_dimension_2d;
 
 			flush_exclusions.clear();
+			access_history = {};
 
 			// Set to dirty
 			set_dirty(true);
@@ -1481,6 +1625,30 @@ namespace rsx
 			flush_exclusions.clear();
 		}
 
+		/**
+		 * Access history (LRU-2)
+		 */
+		void record_access(u64 frame)
+		{
+			// Multiple reads in one frame count as a single reference
+			if (access_history[0] != frame)
+			{
+				access_history[1] = access_history[0];
+				access_history[0] = frame;
+			}
+		}
+
+		u64 get_last_access() const
+		{
+			return access_history[0];
+		}
+
+		// Backward 2-distance. Sections referenced only once report 0 and are evicted first.
+		u64 get_penultimate_access() const
+		{
+			return access_history[1];
+		}
+
 		bool sync_protection()
 		{
 			if (!buffered_section::sync())
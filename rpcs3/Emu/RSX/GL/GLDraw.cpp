@@ -674,7 +674,7 @@ void GLGSRender::end()
 	m_fragment_constants_buffer->notify();
 	m_transform_constants_buffer->notify();
 
-	m_frame_stats.textures_upload_time += m_profiler.duration();
+	m_frame_stats.draw_exec_time += m_profiler.duration();
 
 	rsx::thread::end();
 }
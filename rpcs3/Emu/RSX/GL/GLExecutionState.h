@@ -25,6 +25,7 @@ namespace gl
 		bool AMD_gpu_shader_half_float_supported = false;
 		bool ARB_compute_shader_supported = false;
 		bool NV_depth_buffer_float_supported = false;
+		bool KHR_parallel_shader_compile_supported = false;
 		bool initialized = false;
 		bool vendor_INTEL = false;  // has broken GLSL compiler
 		bool vendor_AMD = false;    // has broken ARB_multidraw
@@ -44,7 +45,7 @@ namespace gl
 
 		void initialize()
 		{
-			int find_count = 13;
+			int find_count = 14;
 			int ext_count = 0;
 			glGetIntegerv(GL_NUM_EXTENSIONS, &ext_count);
 			std::string vendor_string = reinterpret_cast<const char*>(glGetString(GL_VENDOR));
@@ -147,6 +148,13 @@ namespace gl
 					find_count--;
 					continue;
 				}
+
+				if (check(ext_name, "GL_KHR_parallel_shader_compile"))
+				{
+					KHR_parallel_shader_compile_supported = true;
+					find_count--;
+					continue;
+				}
 			}
 
 			// Check GL_VERSION and GL_RENDERER for the presence of Mesa
@@ -5,6 +5,9 @@
 #include "GLCommonDecompiler.h"
 #include "../GCM.h"
 #include "../Program/GLSLCommon.h"
+#include "../Program/ProgramStateCache.h"
+
+#include "util/serialization.hpp"
 
 std::string GLFragmentDecompilerThread::getFloatTypeName(usz elementCount)
 {
@@ -360,21 +363,43 @@ void GLFragmentProgram::Decompile(const RSXFragmentProgram& prog)
 		decompiler.device_props.has_low_precision_rounding = driver_caps.vendor_NVIDIA;
 	}
 
-	decompiler.Task();
+	auto& cache = rsx::decompiled_program_cache::get();
+	const u64 variant = (u64{0x474c4650} << 32) |                // 'GLFP'
+		(u64{decompiler.device_props.has_native_half_support} << 0) |
+		(u64{decompiler.device_props.has_low_precision_rounding} << 1) |
+		(u64{gl::get_driver_caps().vendor_NVIDIA} << 2);
+	const u64 key = cache.get_key(prog, variant);
 
-	for (const ParamType& PT : decompiler.m_parr.params[PF_PARAM_UNIFORM])
+	if (const auto cached = cache.find(key))
 	{
-		for (const ParamItem& PI : PT.items)
-		{
-			if (PT.type == "sampler1D" ||
-				PT.type == "sampler2D" ||
-				PT.type == "sampler3D" ||
-				PT.type == "samplerCube")
-				continue;
+		source = cached->source;
+
+		utils::serial ar;
+		ar.set_reading_state(std::vector<u8>(cached->metadata));
+		ar(FragmentConstantOffsetCache);
+	}
+	else
+	{
+		decompiler.Task();
 
-			usz offset = atoi(PI.name.c_str() + 2);
-			FragmentConstantOffsetCache.push_back(offset);
+		for (const ParamType& PT : decompiler.m_parr.params[PF_PARAM_UNIFORM])
+		{
+			for (const ParamItem& PI : PT.items)
+			{
+				if (PT.type == "sampler1D" ||
+					PT.type == "sampler2D" ||
+					PT.type == "sampler3D" ||
+					PT.type == "samplerCube")
+					continue;
+
+				usz offset = atoi(PI.name.c_str() + 2);
+				FragmentConstantOffsetCache.push_back(offset);
+			}
 		}
+
+		utils::serial ar;
+		ar(FragmentConstantOffsetCache);
+		cache.insert(key, source, std::move(ar.data));
 	}
 
 	shader.create(::glsl::program_domain::glsl_fragment_program, source);
@@ -20,7 +20,7 @@ GLGSRender::GLGSRender() : GSRender()
 	if (g_cfg.video.disable_vertex_cache || g_cfg.video.multithreaded_rsx)
 		m_vertex_cache = std::make_unique<gl::null_vertex_cache>();
 	else
-		m_vertex_cache = std::make_unique<gl::weak_vertex_cache>();
+		m_vertex_cache = std::make_unique<gl::persistent_vertex_cache>();
 
 	backend_config.supports_hw_a2c = false;
 	backend_config.supports_hw_a2one = false;
@@ -71,12 +71,17 @@ void GLGSRender::on_init_thread()
 			m_frame->set_current(ctx);
 		};
 
+		auto context_release_func = [m_frame = m_frame](draw_context_t ctx)
+		{
+			m_frame->release_current(ctx);
+		};
+
 		auto context_destroy_func = [m_frame = m_frame](draw_context_t ctx)
 		{
 			m_frame->delete_context(ctx);
 		};
 
-		gl::initialize_pipe_compiler(context_create_func, context_bind_func, context_destroy_func, g_cfg.video.shader_compiler_threads_count);
+		gl::initialize_pipe_compiler(context_create_func, context_bind_func, context_release_func, context_destroy_func, g_cfg.video.shader_compiler_threads_count);
 	}
 	else
 	{
@@ -85,7 +90,7 @@ void GLGSRender::on_init_thread()
 			return nullptr;
 		};
 
-		gl::initialize_pipe_compiler(null_context_create_func, {}, {}, 1);
+		gl::initialize_pipe_compiler(null_context_create_func, {}, {}, {}, 1);
 	}
 
 	// Bind primary context to main RSX thread
@@ -388,6 +393,12 @@ void GLGSRender::on_exit()
 		m_vao.remove();
 	}
 
+	if (m_frame_timing_queries[0])
+	{
+		glDeleteQueries(::size32(m_frame_timing_queries), m_frame_timing_queries.data());
+		m_frame_timing_queries = {};
+	}
+
 	m_gl_persistent_stream_buffer.reset();
 	m_gl_volatile_stream_buffer.reset();
 
@@ -660,7 +671,7 @@ bool GLGSRender::load_program()
 
 		if (shadermode == shader_mode::interpreter_only)
 		{
-			m_program = m_shader_interpreter.get(current_fp_metadata);
+			m_program = m_shader_interpreter.get(current_fp_metadata, current_fragment_program.texture_state.texture_dimensions);
 			return true;
 		}
 	}
@@ -706,7 +717,7 @@ bool GLGSRender::load_program()
 	if (!m_program && (shadermode == shader_mode::async_with_interpreter || shadermode == shader_mode::interpreter_only))
 	{
 		// Fall back to interpreter
-		m_program = m_shader_interpreter.get(current_fp_metadata);
+		m_program = m_shader_interpreter.get(current_fp_metadata, current_fragment_program.texture_state.texture_dimensions);
 		if (was_interpreter != m_shader_interpreter.is_interpreter(m_program))
 		{
 			// Program has changed, reupload
@@ -944,6 +955,8 @@ void GLGSRender::on_invalidate_memory_range(const utils::address_range &range, r
 	auto data = m_gl_texture_cache.invalidate_range(cmd, range, cause);
 	AUDIT(data.empty());
 
+	m_vertex_cache->invalidate_range(range);
+
 	if (cause == rsx::invalidation_cause::unmap && data.violation_handled)
 	{
 		m_gl_texture_cache.purge_unreleased_sections();
@@ -1048,6 +1061,13 @@ void GLGSRender::notify_tile_unbound(u32 tile)
 	}
 }
 
+void GLGSRender::get_backend_frame_statistics(rsx::frame_statistics_t& stats)
+{
+	stats.texture_uploads = m_gl_texture_cache.get_texture_upload_calls_this_frame();
+	stats.texture_upload_misses = m_gl_texture_cache.get_texture_upload_misses_this_frame();
+	stats.shader_compiles = m_prog_buffer.pop_compile_count();
+}
+
 void GLGSRender::begin_occlusion_query(rsx::reports::occlusion_query_info* query)
 {
 	query->result = 0;
@@ -20,6 +20,7 @@ namespace gl
 {
 	using vertex_cache = rsx::vertex_cache::default_vertex_cache<rsx::vertex_cache::uploaded_range<GLenum>, GLenum>;
 	using weak_vertex_cache = rsx::vertex_cache::weak_vertex_cache<GLenum>;
+	using persistent_vertex_cache = rsx::vertex_cache::persistent_vertex_cache<GLenum>;
 	using null_vertex_cache = vertex_cache;
 
 	using shader_cache = rsx::shaders_cache<void*, GLProgramBuffer>;
@@ -139,6 +140,13 @@ private:
 	std::unordered_map<GLenum, std::unique_ptr<gl::texture>> m_null_textures;
 	std::vector<u8> m_scratch_buffer;
 
+	// GPU frame timing. Each in-flight frame owns a begin/end timestamp query pair
+	static constexpr u32 frame_timing_slots = 4;
+	std::array<GLuint, frame_timing_slots * 2> m_frame_timing_queries = {};
+	std::array<bool, frame_timing_slots> m_frame_timing_pending = {};
+	u32 m_frame_timing_index = 0;
+	bool m_frame_timing_open = false;
+
 public:
 	u64 get_cycles() final;
 	GLGSRender();
@@ -164,6 +172,9 @@ private:
 
 	gl::texture* get_present_source(gl::present_surface_info* info, const rsx::avconf& avconfig);
 
+	void begin_frame_timing();
+	void end_frame_timing();
+
 public:
 	void set_viewport();
 	void set_scissor(bool clip_viewport);
@@ -187,6 +198,7 @@ protected:
 	void on_init_thread() override;
 	void on_exit() override;
 	void flip(const rsx::display_flip_info_t& info) override;
+	void get_backend_frame_statistics(rsx::frame_statistics_t& stats) override;
 
 	void do_local_task(rsx::FIFO_state state) override;
 
@@ -776,6 +776,9 @@ namespace gl
 		u32 m_data_loc = 0;
 		void *m_memory_mapping = nullptr;
 
+		// Absolute position of the heap base, see get_allocation_marker()
+		u64 m_allocation_base = 0;
+
 		fence m_fence;
 
 	public:
@@ -800,6 +803,7 @@ namespace gl
 			ensure(m_memory_mapping != nullptr);
 			m_data_loc = 0;
 			m_size = ::narrow<u32>(size);
+			m_allocation_base += 2 * static_cast<u64>(m_size) + 1;
 		}
 
 		void create(target target_, GLsizeiptr size, const void* data_ = nullptr)
@@ -825,6 +829,7 @@ namespace gl
 					glFinish();
 				}
 
+				m_allocation_base += static_cast<u64>(m_size);
 				m_data_loc = 0;
 				offset = 0;
 			}
@@ -856,6 +861,12 @@ namespace gl
 
 		virtual void reserve_storage_on_heap(u32 /*alloc_size*/) {}
 
+		// Monotonic allocation position. A block allocated after marker M has not been overwritten while (current marker - M) <= size()
+		u64 get_allocation_marker() const
+		{
+			return m_allocation_base + m_data_loc;
+		}
+
 		virtual void unmap() {}
 
 		//Notification of a draw command
@@ -887,6 +898,7 @@ namespace gl
 			m_memory_mapping = nullptr;
 			m_data_loc = 0;
 			m_size = ::narrow<u32>(size);
+			m_allocation_base += 2 * static_cast<u64>(m_size) + 1;
 		}
 
 		void create(target target_, GLsizeiptr size, const void* data_ = nullptr)
@@ -906,7 +918,9 @@ namespace gl
 
 			if ((offset + block_size) > m_size)
 			{
+				// Orphaning discards the previous contents
 				buffer::data(m_size, nullptr, GL_DYNAMIC_DRAW);
+				m_allocation_base += 2 * static_cast<u64>(m_size) + 1;
 				m_data_loc = 0;
 			}
 
@@ -2581,7 +2595,24 @@ public:
 			void link(std::function<void(program*)> init_func = {})
 			{
 				glLinkProgram(m_id);
+				finalize_link(init_func);
+			}
 
+			// Starts linking without querying the result. With KHR_parallel_shader_compile the driver completes it in the background
+			void link_async()
+			{
+				glLinkProgram(m_id);
+			}
+
+			bool is_link_complete() const
+			{
+				GLint status = GL_TRUE;
+				glGetProgramiv(m_id, GL_COMPLETION_STATUS_KHR, &status);
+				return status != GL_FALSE;
+			}
+
+			void finalize_link(std::function<void(program*)> init_func = {})
+			{
 				GLint status = GL_FALSE;
 				glGetProgramiv(m_id, GL_LINK_STATUS, &status);
 
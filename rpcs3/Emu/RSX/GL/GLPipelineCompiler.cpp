@@ -28,24 +28,107 @@ namespace gl
 	void pipe_compiler::initialize(
 		std::function<draw_context_t()> context_create_func,
 		std::function<void(draw_context_t)> context_bind_func,
+		std::function<void(draw_context_t)> context_release_func,
 		std::function<void(draw_context_t)> context_destroy_func)
 	{
 		m_context_bind_func = context_bind_func;
+		m_context_release_func = context_release_func;
 		m_context_destroy_func = context_destroy_func;
 
 		m_context = context_create_func();
 	}
 
+	bool pipe_compiler::can_lend_context() const
+	{
+		return m_context && m_context_release_func && m_context_state == context_state::idle;
+	}
+
+	bool pipe_compiler::lend_context()
+	{
+		if (!m_context || !m_context_release_func)
+		{
+			return false;
+		}
+
+		if (!m_context_state.compare_and_swap_test(context_state::idle, context_state::lent))
+		{
+			return false;
+		}
+
+		m_context_bind_func(m_context);
+		return true;
+	}
+
+	void pipe_compiler::return_context()
+	{
+		ensure(m_context_state == context_state::lent);
+
+		m_context_release_func(m_context);
+		m_context_state = context_state::idle;
+		m_context_state.notify_all();
+	}
+
+	void pipe_compiler::bind_worker_context()
+	{
+		if (m_context_state == context_state::bound)
+		{
+			return;
+		}
+
+		// A lent context has to be released by the borrower before it can become current here
+		while (!m_context_state.compare_and_swap_test(context_state::idle, context_state::bound))
+		{
+			thread_ctrl::wait_on(m_context_state, context_state::lent);
+		}
+
+		m_context_bind_func(m_context);
+
+		if (get_driver_caps().KHR_parallel_shader_compile_supported)
+		{
+			// Let the driver pick its thread count, links are polled for completion instead of waited on
+			glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+		}
+	}
+
+	void pipe_compiler::poll_pending_links()
+	{
+		for (auto it = m_pending_links.begin(); it != m_pending_links.end();)
+		{
+			if (!it->program->is_link_complete())
+			{
+				++it;
+				continue;
+			}
+
+			it->program->finalize_link(it->job.post_link_func);
+			it->job.completion_callback(it->program);
+			it = m_pending_links.erase(it);
+		}
+	}
+
 	void pipe_compiler::operator()()
 	{
 		while (thread_ctrl::state() != thread_state::aborting)
 		{
 			for (auto&& job : m_work_queue.pop_all())
 			{
-				if (!m_context_ready.test_and_set())
+				// Bind context on first use
+				bind_worker_context();
+
+				if (get_driver_caps().KHR_parallel_shader_compile_supported)
 				{
-					// Bind context on first use
-					m_context_bind_func(m_context);
+					// Issue the link and keep going, the driver finishes it on its own threads
+					auto result = std::make_unique<glsl::program>();
+					result->create();
+
+					if (job.post_create_func)
+					{
+						job.post_create_func(result.get());
+					}
+
+					result->link_async();
+					m_pending_links.push_back({ std::move(result), std::move(job) });
+					continue;
 				}
 
 				auto result = int_compile_graphics_pipe(
@@ -55,8 +138,23 @@ namespace gl
 				job.completion_callback(result);
 			}
 
+			if (!m_pending_links.empty())
+			{
+				poll_pending_links();
+
+				if (!m_pending_links.empty())
+				{
+					// Check again shortly, new jobs are picked up on the next pass
+					thread_ctrl::wait_for(500);
+					continue;
+				}
+			}
+
 			thread_ctrl::wait_on(m_work_queue, nullptr);
 		}
+
+		// Abandon unfinished links while the context is still current
+		m_pending_links.clear();
 	}
 
 	std::unique_ptr<glsl::program> pipe_compiler::compile(
@@ -93,6 +191,7 @@ namespace gl
 	void initialize_pipe_compiler(
 		std::function<draw_context_t()> context_create_func,
 		std::function<void(draw_context_t)> context_bind_func,
+		std::function<void(draw_context_t)> context_release_func,
 		std::function<void(draw_context_t)> context_destroy_func,
 		int num_worker_threads)
 	{
@@ -127,7 +226,7 @@ namespace gl
 		// Initialize the workers. At least one inline compiler shall exist (doesn't actually run)
 		for (pipe_compiler& compiler : *g_pipe_compilers.get())
 		{
-			compiler.initialize(context_create_func, context_bind_func, context_destroy_func);
+			compiler.initialize(context_create_func, context_bind_func, context_release_func, context_destroy_func);
 		}
 	}
 
@@ -143,4 +242,40 @@ namespace gl
 
 		return g_pipe_compilers.get()->begin() + (thread_index % g_num_pipe_compilers);
 	}
+
+	u32 get_idle_pipe_compiler_count()
+	{
+		ensure(g_pipe_compilers);
+
+		u32 result = 0;
+		for (pipe_compiler& compiler : *g_pipe_compilers.get())
+		{
+			if (compiler.can_lend_context())
+			{
+				result++;
+			}
+		}
+
+		return result;
+	}
+
+	pipe_compiler* acquire_pipe_compiler_context()
+	{
+		ensure(g_pipe_compilers);
+
+		for (pipe_compiler& compiler : *g_pipe_compilers.get())
+		{
+			if (compiler.lend_context())
+			{
+				return &compiler;
+			}
+		}
+
+		return nullptr;
+	}
+
+	void release_pipe_compiler_context(pipe_compiler* compiler)
+	{
+		ensure(compiler)->return_context();
+	}
 }
@@ -24,6 +24,7 @@ namespace gl
 		void initialize(
 			std::function<draw_context_t()> context_create_func,
 			std::function<void(draw_context_t)> context_bind_func,
+			std::function<void(draw_context_t)> context_release_func,
 			std::function<void(draw_context_t)> context_destroy_func);
 
 		std::unique_ptr<glsl::program> compile(
@@ -34,6 +35,11 @@ namespace gl
 
 		void operator()();
 
+		// Binds the shared context to the calling thread if the worker has not claimed it yet
+		bool can_lend_context() const;
+		bool lend_context();
+		void return_context();
+
 	private:
 
 		struct pipe_compiler_job
@@ -47,14 +53,34 @@ namespace gl
 			{}
 		};
 
+		struct pending_link
+		{
+			std::unique_ptr<glsl::program> program;
+			pipe_compiler_job job;
+		};
+
+		enum class context_state : u32
+		{
+			idle,  // Not current on any thread
+			lent,  // Bound to a thread outside the pool
+			bound  // Bound to the worker thread
+		};
+
 		lf_queue<pipe_compiler_job> m_work_queue;
 
+		// Links issued with KHR_parallel_shader_compile that the driver has not finished yet
+		std::vector<pending_link> m_pending_links;
+
 		draw_context_t m_context = 0;
-		atomic_t<bool> m_context_ready = false;
+		atomic_t<context_state> m_context_state = context_state::idle;
 
 		std::function<void(draw_context_t context)> m_context_bind_func;
+		std::function<void(draw_context_t context)> m_context_release_func;
 		std::function<void(draw_context_t context)> m_context_destroy_func;
 
+		void bind_worker_context();
+		void poll_pending_links();
+
 		std::unique_ptr<glsl::program> int_compile_graphics_pipe(
 			build_callback_t post_create_func, build_callback_t post_link_func);
 	};
@@ -62,9 +88,15 @@ namespace gl
 	void initialize_pipe_compiler(
 		std::function<draw_context_t()> context_create_func,
 		std::function<void(draw_context_t)> context_bind_func,
+		std::function<void(draw_context_t)> context_release_func,
 		std::function<void(draw_context_t)> context_destroy_func,
 		int num_worker_threads = -1);
 
 	void destroy_pipe_compiler();
 	pipe_compiler* get_pipe_compiler();
+
+	// Worker contexts not yet claimed by their compiler thread can be borrowed for bulk work such as the shader cache preload
+	u32 get_idle_pipe_compiler_count();
+	pipe_compiler* acquire_pipe_compiler_context();
+	void release_pipe_compiler_context(pipe_compiler* compiler);
 }
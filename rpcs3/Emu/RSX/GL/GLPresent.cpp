@@ -115,6 +115,64 @@ gl::texture* GLGSRender::get_present_source(gl::present_surface_info* info, cons
 	return image;
 }
 
+void GLGSRender::begin_frame_timing()
+{
+	if (!m_profiler.enabled)
+	{
+		return;
+	}
+
+	if (!m_frame_timing_queries[0])
+	{
+		glGenQueries(::size32(m_frame_timing_queries), m_frame_timing_queries.data());
+	}
+
+	// Retire finished frames, oldest first. The slot about to be reused is the oldest one
+	for (u32 n = 0; n < frame_timing_slots; ++n)
+	{
+		const u32 slot = (m_frame_timing_index + n) % frame_timing_slots;
+		if (!m_frame_timing_pending[slot])
+		{
+			continue;
+		}
+
+		GLint available = GL_FALSE;
+		glGetQueryObjectiv(m_frame_timing_queries[slot * 2 + 1], GL_QUERY_RESULT_AVAILABLE, &available);
+
+		if (!available)
+		{
+			break;
+		}
+
+		GLuint64 begin = 0, end = 0;
+		glGetQueryObjectui64v(m_frame_timing_queries[slot * 2], GL_QUERY_RESULT, &begin);
+		glGetQueryObjectui64v(m_frame_timing_queries[slot * 2 + 1], GL_QUERY_RESULT, &end);
+
+		m_frame_stats.gpu_time = end > begin ? static_cast<s64>((end - begin) / 1000) : 0;
+		m_frame_timing_pending[slot] = false;
+	}
+
+	// If the GPU is too far behind the sample in this slot is dropped rather than stalling
+	m_frame_timing_pending[m_frame_timing_index] = false;
+
+	glQueryCounter(m_frame_timing_queries[m_frame_timing_index * 2], GL_TIMESTAMP);
+	m_frame_timing_open = true;
+}
+
+void GLGSRender::end_frame_timing()
+{
+	if (!m_frame_timing_open)
+	{
+		return;
+	}
+
+	glQueryCounter(m_frame_timing_queries[m_frame_timing_index * 2 + 1], GL_TIMESTAMP);
+
+	m_frame_timing_pending[m_frame_timing_index] = true;
+	m_frame_timing_index = (m_frame_timing_index + 1) % frame_timing_slots;
+	m_frame_timing_open = false;
+}
+
 void GLGSRender::flip(const rsx::display_flip_info_t& info)
 {
 	if (info.skip_frame)
@@ -124,6 +182,8 @@ void GLGSRender::flip(const rsx::display_flip_info_t& info)
 		return;
 	}
 
+	m_profiler.start();
+
 	u32 buffer_width = display_buffers[info.buffer].width;
 	u32 buffer_height = display_buffers[info.buffer].height;
 	u32 buffer_pitch = display_buffers[info.buffer].pitch;
@@ -332,6 +392,7 @@ void GLGSRender::flip(const rsx::display_flip_info_t& info)
 		m_text_printer.print_text(4, 54, width, height, fmt::format("vertex upload time: %8dus", info.stats.vertex_upload_time));
 		m_text_printer.print_text(4, 72, width, height, fmt::format("textures upload time: %6dus", info.stats.textures_upload_time));
 		m_text_printer.print_text(4, 90, width, height, fmt::format("draw call execution: %7dus", info.stats.draw_exec_time));
+		m_text_printer.print_text(4, 108, width, height, fmt::format("GPU frame time: %12dus", info.stats.gpu_time));
 
 		const auto num_dirty_textures = m_gl_texture_cache.get_unreleased_textures_count();
 		const auto texture_memory_size = m_gl_texture_cache.get_texture_memory_in_use() / (1024 * 1024);
@@ -344,10 +405,17 @@ void GLGSRender::flip(const rsx::display_flip_info_t& info)
 		const auto num_texture_upload = m_gl_texture_cache.get_texture_upload_calls_this_frame();
 		const auto num_texture_upload_miss = m_gl_texture_cache.get_texture_upload_misses_this_frame();
 		const auto texture_upload_miss_ratio = m_gl_texture_cache.get_texture_upload_miss_percentage();
+		const auto num_texture_upload_skip = m_gl_texture_cache.get_texture_upload_skips_this_frame();
 		m_text_printer.print_text(4, 126, width, height, fmt::format("Unreleased textures: %7d", num_dirty_textures));
 		m_text_printer.print_text(4, 144, width, height, fmt::format("Texture memory: %12dM", texture_memory_size));
 		m_text_printer.print_text(4, 162, width, height, fmt::format("Flush requests: %12d  = %2d (%3d%%) hard faults, %2d unavoidable, %2d misprediction(s), %2d speculation(s)", num_flushes, num_misses, cache_miss_ratio, num_unavoidable, num_mispredict, num_speculate));
-		m_text_printer.print_text(4, 180, width, height, fmt::format("Texture uploads: %15u (%u from CPU - %02u%%)", num_texture_upload, num_texture_upload_miss, texture_upload_miss_ratio));
+		m_text_printer.print_text(4, 180, width, height, fmt::format("Texture uploads: %15u (%u from CPU - %02u%%, %u unchanged)", num_texture_upload, num_texture_upload_miss, texture_upload_miss_ratio, num_texture_upload_skip));
+
+		const auto texture_memory_usage = m_gl_texture_cache.get_texture_memory_usage();
+		const auto num_evictions = m_gl_texture_cache.get_num_evictions_last_frame();
+		m_text_printer.print_text(4, 198, width, height, fmt::format("Texture memory usage: %5uM sampled, %uM blit src, %uM blit dst, %uM framebuffer, %uM unreleased, %u evicted last frame",
+			texture_memory_usage.shader_read / 0x100000, texture_memory_usage.blit_engine_src / 0x100000, texture_memory_usage.blit_engine_dst / 0x100000,
+			texture_memory_usage.framebuffer_storage / 0x100000, texture_memory_usage.unreleased / 0x100000, num_evictions));
 	}
 
 	if (gl::debug::g_vis_texture)
@@ -374,12 +442,17 @@ void GLGSRender::flip(const rsx::display_flip_info_t& info)
 		m_vis_buffer.remove();
 	}
 
+	end_frame_timing();
+	m_frame_stats.flip_time = m_profiler.duration();
+
 	m_frame->flip(m_context);
 	rsx::thread::flip(info);
 
+	begin_frame_timing();
+
 	// Cleanup
 	m_gl_texture_cache.on_frame_end();
-	m_vertex_cache->purge();
+	m_vertex_cache->on_frame_end();
 
 	gl::command_context cmd{ gl_state };
 	auto removed_textures = m_rtts.free_invalidated(cmd);
@@ -207,6 +207,10 @@ OPENGL_PROC(PFNGLGETQUERYOBJECTIVPROC, GetQueryObjectiv);
 OPENGL_PROC(PFNGLBEGINQUERYPROC, BeginQuery);
 OPENGL_PROC(PFNGLENDQUERYPROC, EndQuery);
 
+// Timer Query
+OPENGL_PROC(PFNGLQUERYCOUNTERPROC, QueryCounter);
+OPENGL_PROC(PFNGLGETQUERYOBJECTUI64VPROC, GetQueryObjectui64v);
+
 // Texture Buffers
 OPENGL_PROC(PFNGLTEXTUREBUFFERRANGEEXTPROC, TextureBufferRangeEXT);
 OPENGL_PROC(PFNGLTEXTUREBUFFERRANGEPROC, TextureBufferRange);
@@ -250,6 +254,9 @@ OPENGL_PROC(PFNGLDISPATCHCOMPUTEPROC, DispatchCompute);
 OPENGL_PROC(PFNGLDEPTHRANGEDNVPROC, DepthRangedNV);
 OPENGL_PROC(PFNGLDEPTHBOUNDSDNVPROC, DepthBoundsdNV);
 
+// KHR_parallel_shader_compile
+OPENGL_PROC(PFNGLMAXSHADERCOMPILERTHREADSKHRPROC, MaxShaderCompilerThreadsKHR);
+
 WGL_PROC(PFNWGLSWAPINTERVALEXTPROC, SwapIntervalEXT);
 
 #if !defined(__GNUG__) || defined(__MINGW32__)
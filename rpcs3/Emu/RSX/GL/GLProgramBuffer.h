@@ -146,6 +146,22 @@ struct GLProgramBuffer : public program_state_cache<GLTraits>
 		search_fragment_program(fp);
 	}
 
+	// The shader cache preload runs one worker per pipe compiler context that can be borrowed
+	u32 get_preload_worker_count() const
+	{
+		return std::max(gl::get_idle_pipe_compiler_count(), 1u);
+	}
+
+	gl::pipe_compiler* acquire_worker_context()
+	{
+		return gl::acquire_pipe_compiler_context();
+	}
+
+	void release_worker_context(gl::pipe_compiler* context)
+	{
+		gl::release_pipe_compiler_context(context);
+	}
+
 	bool check_cache_missed() const
 	{
 		return m_cache_miss_flag;
@@ -46,8 +46,8 @@ namespace gl
 	void shader_interpreter::create()
 	{
 		build_vs();
-		build_program(::program_common::interpreter::COMPILER_OPT_ENABLE_TEXTURES);
-		build_program(::program_common::interpreter::COMPILER_OPT_ENABLE_TEXTURES | ::program_common::interpreter::COMPILER_OPT_ENABLE_F32_EXPORT);
+		build_program(::program_common::interpreter::COMPILER_OPT_ENABLE_TEXTURES | ::program_common::interpreter::COMPILER_OPT_ENABLE_TEXTURE_2D);
+		build_program(::program_common::interpreter::COMPILER_OPT_ENABLE_TEXTURES | ::program_common::interpreter::COMPILER_OPT_ENABLE_TEXTURE_2D | ::program_common::interpreter::COMPILER_OPT_ENABLE_F32_EXPORT);
 	}
 
 	void shader_interpreter::destroy()
@@ -61,7 +61,7 @@ namespace gl
 		m_vs.remove();
 	}
 
-	glsl::program* shader_interpreter::get(const interpreter::program_metadata& metadata)
+	glsl::program* shader_interpreter::get(const interpreter::program_metadata& metadata, u32 fp_texture_dimensions)
 	{
 		// Build options
 		u64 opt = 0;
@@ -101,6 +101,8 @@ namespace gl
 		if (metadata.has_branch_instructions) opt |= program_common::interpreter::COMPILER_OPT_ENABLE_FLOW_CTRL;
 		if (metadata.has_pack_instructions) opt |= program_common::interpreter::COMPILER_OPT_ENABLE_PACKING;
 		if (rsx::method_registers.polygon_stipple_enabled()) opt |= program_common::interpreter::COMPILER_OPT_ENABLE_STIPPLING;
+		if (rsx::method_registers.two_side_light_en()) opt |= program_common::interpreter::COMPILER_OPT_ENABLE_TWO_SIDED_LIGHTING;
+		opt |= program_common::interpreter::get_texture_type_options(metadata.referenced_textures_mask, fp_texture_dimensions);
 
 		if (auto it = m_program_cache.find(opt); it != m_program_cache.end()) [[likely]]
 		{
@@ -268,14 +270,40 @@ namespace gl
 			builder << "#define WITH_STIPPLING\n";
 		}
 
+		if (compiler_options & program_common::interpreter::COMPILER_OPT_ENABLE_TWO_SIDED_LIGHTING)
+		{
+			builder << "#define WITH_TWO_SIDED_LIGHTING\n";
+		}
+
 		if (compiler_options & program_common::interpreter::COMPILER_OPT_ENABLE_TEXTURES)
 		{
-			builder << "#define WITH_TEXTURES\n\n";
+			builder << "#define WITH_TEXTURES\n";
 
+			const u64 texture_types = compiler_options & program_common::interpreter::COMPILER_OPT_TEXTURE_TYPE_MASK;
+			if ((texture_types & (texture_types - 1)) == 0)
+			{
+				builder << "#define WITH_SINGLE_TEXTURE_TYPE\n";
+			}
+
+			// Only the sampler types used by this variant are declared, the others would be optimized out anyway
 			const char* type_names[] = { "sampler1D", "sampler2D", "samplerCube", "sampler3D" };
+			const char* type_defines[] = { "WITH_TEXTURE_1D", "WITH_TEXTURE_2D", "WITH_TEXTURE_CUBE", "WITH_TEXTURE_3D" };
+			for (int i = 0; i < 4; ++i)
+			{
+				if (compiler_options & (program_common::interpreter::COMPILER_OPT_ENABLE_TEXTURE_1D << i))
+				{
+					builder << "#define " << type_defines[i] << "\n";
+				}
+			}
+
+			builder << "\n";
+
 			for (int i = 0; i < 4; ++i)
 			{
-				builder << "uniform " << type_names[i] << " " << type_names[i] << "_array[" << allocator.pools[i].pool_size << "];\n";
+				if (compiler_options & (program_common::interpreter::COMPILER_OPT_ENABLE_TEXTURE_1D << i))
+				{
+					builder << "uniform " << type_names[i] << " " << type_names[i] << "_array[" << allocator.pools[i].pool_size << "];\n";
+				}
 			}
 
 			builder << "\n"
@@ -311,6 +339,7 @@ namespace gl
 	interpreter::cached_program* shader_interpreter::build_program(u64 compiler_options)
 	{
 		auto data = new interpreter::cached_program();
+		data->compiler_options = compiler_options;
 		build_fs(compiler_options, *data);
 
 		data->prog.create().
@@ -335,7 +364,10 @@ namespace gl
 					allocator.pools[i].allocate(assigned++);
 				}
 
-				data->prog.uniforms[type_names[i]] = allocator.pools[i].allocated;
+				if (compiler_options & (program_common::interpreter::COMPILER_OPT_ENABLE_TEXTURE_1D << i))
+				{
+					data->prog.uniforms[type_names[i]] = allocator.pools[i].allocated;
+				}
 			}
 		}
 
@@ -438,9 +470,11 @@ namespace gl
 			}
 		}
 
-		if (allocator.pools[0].flags) m_current_interpreter->prog.uniforms["sampler1D_array"] = allocator.pools[0].allocated;
-		if (allocator.pools[1].flags) m_current_interpreter->prog.uniforms["sampler2D_array"] = allocator.pools[1].allocated;
-		if (allocator.pools[2].flags) m_current_interpreter->prog.uniforms["samplerCube_array"] = allocator.pools[2].allocated;
-		if (allocator.pools[3].flags) m_current_interpreter->prog.uniforms["sampler3D_array"] = allocator.pools[3].allocated;
+		// Pools of sampler types that are not part of this variant have no uniform to update
+		const u64 options = m_current_interpreter->compiler_options;
+		if (allocator.pools[0].flags && (options & program_common::interpreter::COMPILER_OPT_ENABLE_TEXTURE_1D)) m_current_interpreter->prog.uniforms["sampler1D_array"] = allocator.pools[0].allocated;
+		if (allocator.pools[1].flags && (options & program_common::interpreter::COMPILER_OPT_ENABLE_TEXTURE_2D)) m_current_interpreter->prog.uniforms["sampler2D_array"] = allocator.pools[1].allocated;
+		if (allocator.pools[2].flags && (options & program_common::interpreter::COMPILER_OPT_ENABLE_TEXTURE_CUBE)) m_current_interpreter->prog.uniforms["samplerCube_array"] = allocator.pools[2].allocated;
+		if (allocator.pools[3].flags && (options & program_common::interpreter::COMPILER_OPT_ENABLE_TEXTURE_3D)) m_current_interpreter->prog.uniforms["sampler3D_array"] = allocator.pools[3].allocated;
 	}
 }
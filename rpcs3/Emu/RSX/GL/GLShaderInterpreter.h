@@ -59,6 +59,7 @@ namespace gl
 
 		struct cached_program
 		{
+			u64 compiler_options = 0;
 			glsl::shader fs;
 			glsl::program prog;
 			texture_pool_allocator allocator;
@@ -82,7 +83,7 @@ namespace gl
 
 		void update_fragment_textures(const std::array<std::unique_ptr<rsx::sampled_image_descriptor_base>, 16>& descriptors, u16 reference_mask, u32* out);
 
-		glsl::program* get(const interpreter::program_metadata& fp_metadata);
+		glsl::program* get(const interpreter::program_metadata& fp_metadata, u32 fp_texture_dimensions);
 		bool is_interpreter(const glsl::program* program);
 	};
 }
@@ -184,7 +184,6 @@ gl::vertex_upload_info GLGSRender::set_vertex_buffer()
 	{
 		//Check if cacheable
 		//Only data in the 'persistent' block may be cached
-		//TODO: make vertex cache keep local data beyond frame boundaries and hook notify command
 		bool in_cache = false;
 		bool to_store = false;
 		u32  storage_address = -1;
@@ -195,6 +194,8 @@ gl::vertex_upload_info GLGSRender::set_vertex_buffer()
 			const auto data_offset = (vertex_base * m_vertex_layout.interleaved_blocks[0].attribute_stride);
 			storage_address = m_vertex_layout.interleaved_blocks[0].real_offset_address + data_offset;
 
+			m_vertex_cache->update_heap_state(m_attrib_ring_buffer->get_allocation_marker(), static_cast<u64>(m_attrib_ring_buffer->size()));
+
 			if (auto cached = m_vertex_cache->find_vertex_range(storage_address, GL_R8UI, required.first))
 			{
 				ensure(cached->local_address == storage_address);
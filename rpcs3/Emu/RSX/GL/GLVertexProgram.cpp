@@ -5,6 +5,7 @@
 
 #include "GLCommonDecompiler.h"
 #include "../Program/GLSLCommon.h"
+#include "../Program/ProgramStateCache.h"
 
 #include <algorithm>
 
@@ -269,8 +270,24 @@ GLVertexProgram::~GLVertexProgram()
 void GLVertexProgram::Decompile(const RSXVertexProgram& prog)
 {
 	std::string source;
-	GLVertexDecompilerThread decompiler(prog, source, parr);
-	decompiler.Task();
+
+	auto& cache = rsx::decompiled_program_cache::get();
+	const auto& dev_caps = gl::get_driver_caps();
+	const u64 variant = (u64{0x474c5650} << 32) |                // 'GLVP'
+		(u64{dev_caps.NV_depth_buffer_float_supported} << 0) |
+		(u64{dev_caps.vendor_INTEL} << 1);
+	const u64 key = cache.get_key(prog, variant);
+
+	if (const auto cached = cache.find(key))
+	{
+		source = cached->source;
+	}
+	else
+	{
+		GLVertexDecompilerThread decompiler(prog, source, parr);
+		decompiler.Task();
+		cache.insert(key, source, {});
+	}
 
 	shader.create(::glsl::program_domain::glsl_vertex_program, source);
 	id = shader.id();
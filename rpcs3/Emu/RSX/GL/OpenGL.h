@@ -36,6 +36,10 @@ typedef BOOL (WINAPI* PFNWGLSWAPINTERVALEXTPROC) (int interval);
 #define GL_TEXTURE_BUFFER_BINDING 0x8C2A
 #endif
 
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
 namespace gl
 {
 	void init();
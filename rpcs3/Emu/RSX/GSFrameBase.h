@@ -22,6 +22,7 @@ public:
 	virtual void delete_context(draw_context_t ctx) = 0;
 	virtual draw_context_t make_context() = 0;
 	virtual void set_current(draw_context_t ctx) = 0;
+	virtual void release_current(draw_context_t ctx) = 0;
 	virtual void flip(draw_context_t ctx, bool skip_frame = false) = 0;
 	virtual int client_width() = 0;
 	virtual int client_height() = 0;
@@ -45,10 +45,12 @@ void GSRender::on_exit()
 	rsx::thread::on_exit();
 }
 
-void GSRender::flip(const rsx::display_flip_info_t&)
+void GSRender::flip(const rsx::display_flip_info_t& info)
 {
 	if (m_frame)
 	{
 		m_frame->flip(m_context);
 	}
+
+	rsx::thread::flip(info);
 }
@@ -1,6 +1,41 @@
 #include "stdafx.h"
 #include "NullGSRender.h"
 
+#include "Emu/RSX/Common/BufferUtils.h"
+#include "Emu/RSX/rsx_methods.h"
+#include "Emu/RSX/rsx_utils.h"
+#include "Emu/system_config.h"
+
+namespace
+{
+	// Textures are decoded into host memory only, so there is no component remapping to report
+	struct null_sampled_image_descriptor : public rsx::sampled_image_descriptor_base
+	{
+		u32 encoded_component_map() const override
+		{
+			return 0u;
+		}
+	};
+
+	template <typename T>
+	void fill_surface(std::vector<u8>& data, T value, T mask)
+	{
+		const auto dst = reinterpret_cast<T*>(data.data());
+		const usz count = data.size() / sizeof(T);
+
+		if (mask == static_cast<T>(umax))
+		{
+			std::fill_n(dst, count, value);
+			return;
+		}
+
+		for (usz i = 0; i < count; ++i)
+		{
+			dst[i] = (dst[i] & ~mask) | (value & mask);
+		}
+	}
+}
+
 u64 NullGSRender::get_cycles()
 {
 	return thread_ctrl::get_cycles(static_cast<named_thread<NullGSRender>&>(*this));
@@ -8,10 +43,493 @@ u64 NullGSRender::get_cycles()
 
 NullGSRender::NullGSRender() : GSRender()
 {
+	m_full_pipeline = g_cfg.video.null_renderer_full_pipeline.get();
+}
+
+NullGSRender::host_surface* NullGSRender::bind_surface(u32 address, u32 pitch, u32 height, u8 bpp, bool is_depth)
+{
+	const auto range = utils::address_range::start_length(address, pitch * height);
+	const auto is_bound = [this](const host_surface* surface)
+	{
+		return surface == m_bound_depth_surface || std::find(m_bound_color_surfaces.begin(), m_bound_color_surfaces.end(), surface) != m_bound_color_surfaces.end();
+	};
+
+	// Surfaces that are partially overwritten by the new target are dropped, like an unresolved surface store overlap
+	for (auto It = m_surfaces.begin(); It != m_surfaces.end();)
+	{
+		if (It->first != address && !is_bound(&It->second) && It->second.get_memory_range().overlaps(range))
+		{
+			It = m_surfaces.erase(It);
+			continue;
+		}
+
+		++It;
+	}
+
+	auto& surface = m_surfaces[address];
+	if (surface.pitch != pitch || surface.height != height || surface.bpp != bpp || surface.is_depth != is_depth)
+	{
+		surface.address = address;
+		surface.pitch = pitch;
+		surface.height = height;
+		surface.bpp = bpp;
+		surface.is_depth = is_depth;
+		surface.data.assign(usz{pitch} * height, 0);
+	}
+
+	return &surface;
+}
+
+void NullGSRender::prepare_framebuffer(rsx::framebuffer_creation_context context)
+{
+	if (m_current_framebuffer_context == context && !m_rtts_dirty)
+	{
+		// Framebuffer configuration has not changed
+		return;
+	}
+
+	m_rtts_dirty = false;
+	framebuffer_status_valid = false;
+	m_framebuffer_state_contested = false;
+
+	get_framebuffer_layout(context, m_framebuffer_layout);
+	if (!framebuffer_status_valid || m_framebuffer_layout.ignore_change)
+	{
+		return;
+	}
+
+	m_bound_color_surfaces = {};
+	m_bound_depth_surface = nullptr;
+
+	const u32 surface_height = m_framebuffer_layout.height * m_framebuffer_layout.aa_factors[1];
+	const u8 color_bpp = get_format_block_size_in_bytes(m_framebuffer_layout.color_format);
+	const u8 depth_bpp = get_format_block_size_in_bytes(m_framebuffer_layout.depth_format);
+
+	for (u32 i = 0; i < rsx::limits::color_buffers_count; ++i)
+	{
+		if (const u32 address = m_framebuffer_layout.color_addresses[i])
+		{
+			m_bound_color_surfaces[i] = bind_surface(address, m_framebuffer_layout.actual_color_pitch[i], surface_height, color_bpp, false);
+		}
+	}
+
+	if (const u32 address = m_framebuffer_layout.zeta_address)
+	{
+		m_bound_depth_surface = bind_surface(address, m_framebuffer_layout.actual_zeta_pitch, surface_height, depth_bpp, true);
+	}
+}
+
+template <typename T>
+void NullGSRender::upload_texture(const T& tex, std::unique_ptr<rsx::sampled_image_descriptor_base>& sampler_state)
+{
+	const u32 format = tex.format() & ~(CELL_GCM_TEXTURE_LN | CELL_GCM_TEXTURE_UN);
+	const bool is_swizzled = !(tex.format() & CELL_GCM_TEXTURE_LN);
+	const u32 address = rsx::get_address(tex.offset(), tex.location());
+
+	sampler_state->image_type = tex.get_extended_texture_dimension();
+	sampler_state->format_class = rsx::classify_format(format);
+	sampler_state->ref_address = address;
+
+	m_texture_uploads++;
+
+	// Skip the decode when the same image was already decoded from identical memory contents
+	const u64 content_hash = rsx::hash_guest_memory(address, static_cast<u32>(get_texture_size(tex))) ^ (u64{tex.format()} << 56);
+	if (auto found = m_texture_hashes.find(address); found != m_texture_hashes.end() && found->second == content_hash)
+	{
+		return;
+	}
+
+	m_texture_hashes[address] = content_hash;
+	m_texture_upload_misses++;
+
+	// Decode every subresource on the CPU, the same way a backend without hardware byteswap or deswizzle support would
+	rsx::texture_uploader_capabilities caps{ false, false, false, false, 4 };
+	const u32 texel_size = std::max<u32>(rsx::get_format_block_size_in_bytes(format), 4);
+
+	for (const rsx::subresource_layout& layout : get_subresources_layout(tex))
+	{
+		const usz required = usz{utils::align<u32>(layout.width_in_texel, 4)} * utils::align<u32>(layout.height_in_texel, 4) * layout.depth * texel_size;
+		if (m_texture_staging_buffer.size() < required)
+		{
+			m_texture_staging_buffer.resize(required);
+		}
+
+		upload_texture_subresource({ m_texture_staging_buffer.data(), required }, layout, format, is_swizzled, caps);
+	}
+}
+
+void NullGSRender::load_texture_env()
+{
+	for (u32 textures_ref = current_fp_metadata.referenced_textures_mask, i = 0; textures_ref; textures_ref >>= 1, ++i)
+	{
+		if (!(textures_ref & 1))
+			continue;
+
+		if (!fs_sampler_state[i])
+			fs_sampler_state[i] = std::make_unique<null_sampled_image_descriptor>();
+
+		if (m_textures_dirty[i])
+		{
+			if (const auto& tex = rsx::method_registers.fragment_textures[i]; tex.enabled())
+			{
+				upload_texture(tex, fs_sampler_state[i]);
+			}
+
+			m_textures_dirty[i] = false;
+		}
+	}
+
+	for (u32 textures_ref = current_vp_metadata.referenced_textures_mask, i = 0; textures_ref; textures_ref >>= 1, ++i)
+	{
+		if (!(textures_ref & 1))
+			continue;
+
+		if (!vs_sampler_state[i])
+			vs_sampler_state[i] = std::make_unique<null_sampled_image_descriptor>();
+
+		if (m_vertex_textures_dirty[i])
+		{
+			if (const auto& tex = rsx::method_registers.vertex_textures[i]; tex.enabled())
+			{
+				upload_texture(tex, vs_sampler_state[i]);
+			}
+
+			m_vertex_textures_dirty[i] = false;
+		}
+	}
+}
+
+void NullGSRender::load_program_env()
+{
+	if (m_graphics_state & rsx::pipeline_state::invalidate_pipeline_bits)
+	{
+		get_current_fragment_program(fs_sampler_state);
+		ensure(current_fragment_program.valid);
+
+		get_current_vertex_program(vs_sampler_state);
+
+		// A program pair seen for the first time is what a GPU backend would have to compile
+		const u64 pipeline_hash = program_hash_util::vertex_program_storage_hash{}(current_vertex_program) ^
+			(u64{program_hash_util::fragment_program_storage_hash{}(current_fragment_program)} << 1);
+
+		if (m_known_programs.insert(pipeline_hash).second)
+		{
+			m_shader_compiles++;
+		}
+	}
+
+	if (m_graphics_state & rsx::pipeline_state::vertex_state_dirty)
+	{
+		fill_scale_offset_data(m_vertex_env_buffer.data(), false);
+		fill_user_clip_data(m_vertex_env_buffer.data() + 64);
+		*(reinterpret_cast<u32*>(m_vertex_env_buffer.data() + 128)) = rsx::method_registers.transform_branch_bits();
+		*(reinterpret_cast<f32*>(m_vertex_env_buffer.data() + 132)) = rsx::method_registers.point_size();
+		*(reinterpret_cast<f32*>(m_vertex_env_buffer.data() + 136)) = rsx::method_registers.clip_min();
+		*(reinterpret_cast<f32*>(m_vertex_env_buffer.data() + 140)) = rsx::method_registers.clip_max();
+	}
+
+	if (m_graphics_state & rsx::pipeline_state::transform_constants_dirty)
+	{
+		fill_vertex_program_constants_data(m_transform_constants_buffer.data());
+	}
+
+	if (m_graphics_state & rsx::pipeline_state::fragment_state_dirty)
+	{
+		fill_fragment_state_buffer(m_fragment_env_buffer.data(), current_fragment_program);
+	}
+
+	m_graphics_state &= ~(rsx::pipeline_state::fragment_state_dirty | rsx::pipeline_state::vertex_state_dirty | rsx::pipeline_state::transform_constants_dirty |
+		rsx::pipeline_state::fragment_constants_dirty | rsx::pipeline_state::fragment_texture_state_dirty | rsx::pipeline_state::polygon_stipple_pattern_dirty);
+}
+
+void NullGSRender::begin()
+{
+	rsx::thread::begin();
+
+	if (!m_full_pipeline || skip_current_frame || cond_render_ctrl.disable_rendering())
+		return;
+
+	prepare_framebuffer(rsx::framebuffer_creation_context::context_draw);
 }
 
 void NullGSRender::end()
 {
-	execute_nop_draw();
+	if (!m_full_pipeline || skip_current_frame || !framebuffer_status_valid || cond_render_ctrl.disable_rendering())
+	{
+		execute_nop_draw();
+		rsx::thread::end();
+		return;
+	}
+
+	m_profiler.start();
+
+	analyse_current_rsx_pipeline();
+	m_frame_stats.setup_time += m_profiler.duration();
+
+	load_texture_env();
+	m_frame_stats.textures_upload_time += m_profiler.duration();
+
+	load_program_env();
+	m_frame_stats.setup_time += m_profiler.duration();
+
+	rsx::method_registers.current_draw_clause.begin();
+	u32 subdraw = 0u;
+	do
+	{
+		emit_geometry(subdraw++);
+	}
+	while (rsx::method_registers.current_draw_clause.next());
+
+	m_frame_stats.draw_exec_time += m_profiler.duration();
+
 	rsx::thread::end();
 }
+
+void NullGSRender::emit_geometry(u32 sub_index)
+{
+	if (!sub_index)
+	{
+		analyse_inputs_interleaved(m_vertex_layout);
+		if (!m_vertex_layout.validate())
+		{
+			// Execute remainining pipeline barriers with NOP draw
+			do
+			{
+				rsx::method_registers.current_draw_clause.execute_pipeline_dependencies();
+			}
+			while (rsx::method_registers.current_draw_clause.next());
+
+			rsx::method_registers.current_draw_clause.end();
+			return;
+		}
+	}
+	else
+	{
+		if (rsx::method_registers.current_draw_clause.execute_pipeline_dependencies() & rsx::vertex_base_changed)
+		{
+			// Rebase vertex bases
+			for (auto& info : m_vertex_layout.interleaved_blocks)
+			{
+				const auto vertex_base_offset = rsx::method_registers.vertex_data_base_offset();
+				info.real_offset_address = rsx::get_address(rsx::get_vertex_offset_from_base(vertex_base_offset, info.base_offset), info.memory_location);
+			}
+		}
+	}
+
+	// Write index buffers and count verts
+	const auto& clause = rsx::method_registers.current_draw_clause;
+	const auto command = get_draw_command(rsx::method_registers);
+
+	u32 min_index = 0, max_index = 0;
+	bool index_rebase = false;
+
+	if (const auto indexed = std::get_if<rsx::draw_indexed_array_command>(&command))
+	{
+		const auto type = clause.is_immediate_draw ? rsx::index_array_type::u32 : rsx::method_registers.index_type();
+		const u32 max_size = get_index_count(clause.primitive, clause.get_elements_count()) * get_index_type_size(type);
+		m_index_buffer.resize(max_size);
+
+		u32 index_count;
+		std::tie(min_index, max_index, index_count) = write_index_array_data_to_buffer(
+			m_index_buffer,
+			indexed->raw_index_buffer, type,
+			clause.primitive,
+			rsx::method_registers.restart_index_enabled(),
+			rsx::method_registers.restart_index(),
+			[](auto prim) { return !is_primitive_native(prim); });
+
+		if (min_index >= max_index)
+		{
+			// Empty set, do not draw
+			return;
+		}
+
+		index_rebase = true;
+	}
+	else
+	{
+		u32 vertex_count;
+		if (std::holds_alternative<rsx::draw_inlined_array>(command))
+		{
+			const u32 stride = m_vertex_layout.interleaved_blocks.empty() ? 0 : m_vertex_layout.interleaved_blocks[0].attribute_stride;
+			vertex_count = stride ? u32(clause.inline_vertex_array.size() * sizeof(u32)) / stride : 0;
+		}
+		else
+		{
+			vertex_count = clause.get_elements_count();
+			min_index = clause.min_index();
+		}
+
+		if (!vertex_count)
+		{
+			// Malformed vertex setup; abort
+			return;
+		}
+
+		max_index = (min_index + vertex_count) - 1;
+
+		if (!is_primitive_native(clause.primitive))
+		{
+			// Emulated primitives are drawn through a generated index buffer
+			m_index_buffer.resize(get_index_count(clause.primitive, vertex_count) * sizeof(u16));
+			write_index_array_for_non_indexed_non_native_primitive_to_buffer(reinterpret_cast<char*>(m_index_buffer.data()), clause.primitive, vertex_count);
+		}
+	}
+
+	const u32 vertex_count = (max_index - min_index) + 1;
+	u32 vertex_base = min_index;
+
+	if (index_rebase)
+	{
+		vertex_base = rsx::get_index_from_base(vertex_base, rsx::method_registers.vertex_data_base_index());
+	}
+
+	// Do actual vertex upload
+	const auto required = calculate_memory_requirements(m_vertex_layout, vertex_base, vertex_count);
+	m_persistent_vertex_buffer.resize(required.first);
+	m_volatile_vertex_buffer.resize(required.second);
+
+	write_vertex_data_to_memory(m_vertex_layout, vertex_base, vertex_count,
+		required.first ? m_persistent_vertex_buffer.data() : nullptr,
+		required.second ? m_volatile_vertex_buffer.data() : nullptr);
+
+	fill_vertex_layout_state(m_vertex_layout, vertex_base, vertex_count, m_vertex_layout_buffer.data());
+
+	m_frame_stats.vertex_upload_time += m_profiler.duration();
+}
+
+void NullGSRender::clear_surface(u32 arg)
+{
+	if (!m_full_pipeline || skip_current_frame) return;
+
+	// If stencil write mask is disabled, remove clear_stencil bit
+	if (!rsx::method_registers.stencil_mask()) arg &= ~0x2u;
+
+	// Ignore invalid clear flags
+	if ((arg & 0xf3) == 0) return;
+
+	u8 ctx = rsx::framebuffer_creation_context::context_draw;
+	if (arg & 0xF0) ctx |= rsx::framebuffer_creation_context::context_clear_color;
+	if (arg & 0x3) ctx |= rsx::framebuffer_creation_context::context_clear_depth;
+
+	prepare_framebuffer(static_cast<rsx::framebuffer_creation_context>(ctx));
+
+	if (!framebuffer_status_valid) return;
+
+	if (auto ds = m_bound_depth_surface; ds && (arg & 0x3))
+	{
+		const auto surface_depth_format = rsx::method_registers.surface_depth_fmt();
+
+		if (is_depth_stencil_format(surface_depth_format))
+		{
+			// Depth occupies the upper 24 bits, stencil the lower 8
+			u32 value = 0, mask = 0;
+
+			if (arg & 0x1)
+			{
+				value |= rsx::method_registers.z_clear_value(true) << 8;
+				mask |= 0xFFFFFF00;
+			}
+
+			if (arg & 0x2)
+			{
+				value |= rsx::method_registers.stencil_clear_value();
+				mask |= rsx::method_registers.stencil_mask();
+			}
+
+			fill_surface<u32>(ds->data, value, mask);
+		}
+		else if (arg & 0x1)
+		{
+			fill_surface<u16>(ds->data, static_cast<u16>(rsx::method_registers.z_clear_value(false)), 0xFFFF);
+		}
+	}
+
+	if (arg & 0xF0)
+	{
+		u8 clear_a = rsx::method_registers.clear_color_a();
+		u8 clear_r = rsx::method_registers.clear_color_r();
+		u8 clear_g = rsx::method_registers.clear_color_g();
+		u8 clear_b = rsx::method_registers.clear_color_b();
+
+		u32 value = 0;
+		u32 mask = 0;
+
+		switch (rsx::method_registers.surface_color())
+		{
+		case rsx::surface_color_format::x32:
+		case rsx::surface_color_format::w16z16y16x16:
+		case rsx::surface_color_format::w32z32y32x32:
+		{
+			// Nop
+			return;
+		}
+		case rsx::surface_color_format::b8:
+		{
+			value = clear_b;
+			mask = 0xFF;
+			break;
+		}
+		case rsx::surface_color_format::g8b8:
+		{
+			rsx::get_g8b8_clear_color(clear_r, clear_g, clear_b, clear_a);
+			value = (u32{clear_g} << 8) | clear_b;
+			mask = 0xFFFF;
+			break;
+		}
+		case rsx::surface_color_format::r5g6b5:
+		{
+			value = (u32{clear_r} >> 3) << 11 | (u32{clear_g} >> 2) << 5 | (u32{clear_b} >> 3);
+			mask = 0xFFFF;
+			break;
+		}
+		case rsx::surface_color_format::x1r5g5b5_o1r5g5b5:
+		case rsx::surface_color_format::x1r5g5b5_z1r5g5b5:
+		{
+			value = (u32{clear_r} >> 3) << 10 | (u32{clear_g} >> 3) << 5 | (u32{clear_b} >> 3);
+			mask = 0xFFFF;
+			break;
+		}
+		case rsx::surface_color_format::a8b8g8r8:
+		case rsx::surface_color_format::x8b8g8r8_o8b8g8r8:
+		case rsx::surface_color_format::x8b8g8r8_z8b8g8r8:
+		{
+			rsx::get_abgr8_clear_color(clear_r, clear_g, clear_b, clear_a);
+			[[fallthrough]];
+		}
+		default:
+		{
+			// Per-channel write mask, only honoured for 32-bit targets
+			value = (u32{clear_a} << 24) | (u32{clear_r} << 16) | (u32{clear_g} << 8) | clear_b;
+			if (arg & 0x10) mask |= 0x00FF0000;
+			if (arg & 0x20) mask |= 0x0000FF00;
+			if (arg & 0x40) mask |= 0x000000FF;
+			if (arg & 0x80) mask |= 0xFF000000;
+			break;
+		}
+		}
+
+		for (const auto surface : m_bound_color_surfaces)
+		{
+			if (!surface)
+			{
+				continue;
+			}
+
+			switch (surface->bpp)
+			{
+			case 1: fill_surface<u8>(surface->data, static_cast<u8>(value), static_cast<u8>(mask)); break;
+			case 2: fill_surface<u16>(surface->data, static_cast<u16>(value), static_cast<u16>(mask)); break;
+			case 4: fill_surface<u32>(surface->data, value, mask); break;
+			default: break;
+			}
+		}
+	}
+}
+
+void NullGSRender::get_backend_frame_statistics(rsx::frame_statistics_t& stats)
+{
+	stats.texture_uploads = std::exchange(m_texture_uploads, 0);
+	stats.texture_upload_misses = std::exchange(m_texture_upload_misses, 0);
+	stats.shader_compiles = std::exchange(m_shader_compiles, 0);
+}
@@ -1,5 +1,9 @@
 #pragma once
 #include "Emu/RSX/GSRender.h"
+#include "Emu/RSX/Common/TextureUtils.h"
+
+#include <unordered_map>
+#include <unordered_set>
 
 class NullGSRender : public GSRender
 {
@@ -8,5 +12,65 @@ public:
 	NullGSRender();
 
 private:
+	// Render target contents backed by host memory
+	struct host_surface
+	{
+		u32 address = 0;
+		u32 pitch = 0;
+		u32 height = 0;
+		u8 bpp = 0;
+		bool is_depth = false;
+		std::vector<u8> data;
+
+		utils::address_range get_memory_range() const
+		{
+			return utils::address_range::start_length(address, pitch * height);
+		}
+	};
+
+	// Runs the full front-end against host memory instead of dropping draws
+	bool m_full_pipeline = false;
+
+	std::array<std::unique_ptr<rsx::sampled_image_descriptor_base>, rsx::limits::fragment_textures_count> fs_sampler_state = {};
+	std::array<std::unique_ptr<rsx::sampled_image_descriptor_base>, rsx::limits::vertex_textures_count> vs_sampler_state = {};
+
+	std::unordered_map<u32, host_surface> m_surfaces;
+	std::array<host_surface*, rsx::limits::color_buffers_count> m_bound_color_surfaces = {};
+	host_surface* m_bound_depth_surface = nullptr;
+
+	// Content hash of the last decoded texture at each address
+	std::unordered_map<u32, u64> m_texture_hashes;
+	std::unordered_set<u64> m_known_programs;
+
+	rsx::vertex_input_layout m_vertex_layout;
+
+	std::vector<std::byte> m_texture_staging_buffer;
+	std::vector<std::byte> m_index_buffer;
+	std::vector<u8> m_persistent_vertex_buffer;
+	std::vector<u8> m_volatile_vertex_buffer;
+
+	// Constant buffers are filled with streaming stores and must stay 16-byte aligned
+	alignas(16) std::array<u8, 144> m_vertex_env_buffer = {};
+	alignas(16) std::array<u8, 8192> m_transform_constants_buffer = {};
+	alignas(16) std::array<u8, 32> m_fragment_env_buffer = {};
+	std::array<s32, 16 * 2> m_vertex_layout_buffer = {};
+
+	u32 m_texture_uploads = 0;
+	u32 m_texture_upload_misses = 0;
+	u32 m_shader_compiles = 0;
+
+	host_surface* bind_surface(u32 address, u32 pitch, u32 height, u8 bpp, bool is_depth);
+	void prepare_framebuffer(rsx::framebuffer_creation_context context);
+
+	template <typename T>
+	void upload_texture(const T& tex, std::unique_ptr<rsx::sampled_image_descriptor_base>& sampler_state);
+
+	void load_texture_env();
+	void load_program_env();
+
+	void begin() override;
 	void end() override;
+	void emit_geometry(u32 sub_index) override;
+	void clear_surface(u32 arg) override;
+	void get_backend_frame_statistics(rsx::frame_statistics_t& stats) override;
 };
@@ -236,7 +236,7 @@ namespace rsx
 			case detail_level::minimal: [[fallthrough]];
 			case detail_level::low: m_titles.set_text(""); break;
 			case detail_level::medium: m_titles.set_text(fmt::format("\n\n%s", title1_medium)); break;
-			case detail_level::high: m_titles.set_text(fmt::format("\n\n%s\n\n\n\n\n\n%s", title1_high, title2)); break;
+			case detail_level::high: m_titles.set_text(fmt::format("\n\n%s\n\n\n\n\n\n%s\n\n\n%s", title1_high, title2, title3)); break;
 			}
 			m_titles.auto_resize();
 			m_titles.refresh();
@@ -451,6 +451,20 @@ namespace rsx
 			if (!m_force_update)
 			{
 				++m_frames;
+
+				if (m_detail == detail_level::high)
+				{
+					const auto& stats = g_fxo->get<rsx::thread>().get_last_frame_stats();
+					m_frame_timing_sum.gpu += stats.gpu_time;
+					m_frame_timing_sum.fifo += stats.fifo_time;
+					m_frame_timing_sum.setup += stats.setup_time;
+					m_frame_timing_sum.textures += stats.textures_upload_time;
+					m_frame_timing_sum.vertex += stats.vertex_upload_time;
+					m_frame_timing_sum.draw += stats.draw_exec_time;
+					m_frame_timing_sum.flip += stats.flip_time;
+					m_frame_timing_sum.wait += stats.flip_wait_time;
+					m_frame_timing_samples++;
+				}
 			}
 
 			if (do_update)
@@ -472,6 +486,22 @@ namespace rsx
 
 						m_total_threads = utils::cpu_stats::get_thread_count();
 
+						if (m_frame_timing_samples)
+						{
+							const s64 samples = m_frame_timing_samples;
+							m_frame_timing_avg.gpu = m_frame_timing_sum.gpu / samples;
+							m_frame_timing_avg.fifo = m_frame_timing_sum.fifo / samples;
+							m_frame_timing_avg.setup = m_frame_timing_sum.setup / samples;
+							m_frame_timing_avg.textures = m_frame_timing_sum.textures / samples;
+							m_frame_timing_avg.vertex = m_frame_timing_sum.vertex / samples;
+							m_frame_timing_avg.draw = m_frame_timing_sum.draw / samples;
+							m_frame_timing_avg.flip = m_frame_timing_sum.flip / samples;
+							m_frame_timing_avg.wait = m_frame_timing_sum.wait / samples;
+						}
+
+						m_frame_timing_sum = {};
+						m_frame_timing_samples = 0;
+
 						[[fallthrough]];
 					}
 					case detail_level::medium:
@@ -562,8 +592,19 @@ namespace rsx
 					                         " RSX   : %04.1f %% ( 1)\n"
 					                         " Total : %04.1f %% (%2u)\n\n"
 					                         "%s\n"
-					                         " RSX   : %02u %%",
-					    m_fps, m_frametime, std::string(title1_high.size(), ' '), m_ppu_usage, m_ppus, m_spu_usage, m_spus, m_rsx_usage, m_cpu_usage, m_total_threads, std::string(title2.size(), ' '), m_rsx_load);
+					                         " RSX   : %02u %%\n\n"
+					                         "%s\n"
+					                         " GPU      : %05.2f\n"
+					                         " FIFO     : %05.2f\n"
+					                         " Setup    : %05.2f\n"
+					                         " Textures : %05.2f\n"
+					                         " Vertex   : %05.2f\n"
+					                         " Draw     : %05.2f\n"
+					                         " Flip     : %05.2f\n"
+					                         " Wait     : %05.2f",
+					    m_fps, m_frametime, std::string(title1_high.size(), ' '), m_ppu_usage, m_ppus, m_spu_usage, m_spus, m_rsx_usage, m_cpu_usage, m_total_threads, std::string(title2.size(), ' '), m_rsx_load,
+					    std::string(title3.size(), ' '), m_frame_timing_avg.gpu / 1000., m_frame_timing_avg.fifo / 1000., m_frame_timing_avg.setup / 1000.,
+					    m_frame_timing_avg.textures / 1000., m_frame_timing_avg.vertex / 1000., m_frame_timing_avg.draw / 1000., m_frame_timing_avg.flip / 1000., m_frame_timing_avg.wait / 1000.);
 					break;
 				}
 				}
@@ -16,7 +16,7 @@ namespace rsx
 			// minimal - fps
 			// low - fps, total cpu usage
 			// medium - fps, detailed cpu usage
-			// high - fps, frametime, detailed cpu usage, thread number, rsx load
+			// high - fps, frametime, detailed cpu usage, thread number, rsx load, rsx frame timing breakdown
 			detail_level m_detail{};
 
 			screen_quadrant m_quadrant{};
@@ -57,6 +57,7 @@ namespace rsx
 			const std::string title1_medium{ "CPU Utilization:" };
 			const std::string title1_high{ "Host Utilization (CPU):" };
 			const std::string title2{ "Guest Utilization (PS3):" };
+			const std::string title3{ "Frame Timing (ms):" };
 
 			f32 m_fps{0};
 			f32 m_frametime{0};
@@ -77,6 +78,23 @@ namespace rsx
 			f32 m_rsx_usage{0};
 			u32 m_rsx_load{0};
 
+			// RSX frame timing breakdown in microseconds, accumulated since the last update and averaged per frame
+			struct frame_timing
+			{
+				s64 gpu = 0;
+				s64 fifo = 0;
+				s64 setup = 0;
+				s64 textures = 0;
+				s64 vertex = 0;
+				s64 draw = 0;
+				s64 flip = 0;
+				s64 wait = 0;
+			};
+
+			frame_timing m_frame_timing_sum{};
+			frame_timing m_frame_timing_avg{};
+			u32 m_frame_timing_samples{0};
+
 			void reset_transform(label& elm, u16 bottom_margin = 0) const;
 			void reset_transforms();
 			void reset_body(u16 bottom_margin);
@@ -1,33 +1,32 @@
 #include "stdafx.h"
 #include "ProgramStateCache.h"
 #include "Emu/system_config.h"
+#include "util/serialization.hpp"
+#include "rpcs3_version.h"
 
 #include <stack>
 #include "util/v128.hpp"
 
+#include "xxhash.h"
+#include "emmintrin.h"
+
 using namespace program_hash_util;
 
 usz vertex_program_utils::get_vertex_program_ucode_hash(const RSXVertexProgram &program)
 {
-	// 64-bit Fowler/Noll/Vo FNV-1a hash code
-	usz hash = 0xCBF29CE484222325ULL;
+	const usz count = program.data.size() / 4;
+	ensure(count <= 512);
+
+	// Unreachable slots are zeroed so that leftover ucode does not affect the hash, then the whole block is hashed in one pass
+	alignas(16) std::array<v128, 512> instructions;
 	const void* instbuffer = program.data.data();
-	usz instIndex = 0;
 
-	for (unsigned i = 0; i < program.data.size() / 4; i++)
+	for (usz i = 0; i < count; i++)
 	{
-		if (program.instruction_mask[i])
-		{
-			const auto inst = v128::loadu(instbuffer, instIndex);
-			hash ^= inst._u64[0];
-			hash += (hash << 1) + (hash << 4) + (hash << 5) + (hash << 7) + (hash << 8) + (hash << 40);
-			hash ^= inst._u64[1];
-			hash += (hash << 1) + (hash << 4) + (hash << 5) + (hash << 7) + (hash << 8) + (hash << 40);
-		}
-
-		instIndex++;
+		instructions[i] = program.instruction_mask[i] ? v128::loadu(instbuffer, i) : v128{};
 	}
-	return hash;
+
+	return XXH3_64bits(instructions.data(), count * sizeof(v128));
 }
 
 vertex_program_utils::vertex_program_metadata vertex_program_utils::analyse_vertex_program(const u32* data, u32 entry, RSXVertexProgram& dst_prog)
@@ -250,14 +249,23 @@ vertex_program_utils::vertex_program_metadata vertex_program_utils::analyse_vert
 
 usz vertex_program_storage_hash::operator()(const RSXVertexProgram &program) const
 {
-	usz hash = vertex_program_utils::get_vertex_program_ucode_hash(program);
-	hash ^= program.output_mask;
-	hash ^= program.texture_state.texture_dimensions;
+	u64 hash = program.ucode_hash ? program.ucode_hash : vertex_program_utils::get_vertex_program_ucode_hash(program);
+	hash = rpcs3::hash64(hash, program.output_mask);
+	hash = rpcs3::hash64(hash, program.texture_state.texture_dimensions);
+	hash = rpcs3::hash64(hash, program.entry - program.base_address);
+
+	for (const u32 address : program.jump_table)
+	{
+		hash = rpcs3::hash64(hash, address);
+	}
+
 	return hash;
 }
 
 bool vertex_program_compare::operator()(const RSXVertexProgram &binary1, const RSXVertexProgram &binary2) const
 {
+	if (binary1.ucode_hash && binary2.ucode_hash && binary1.ucode_hash != binary2.ucode_hash)
+		return false;
 	if (binary1.output_mask != binary2.output_mask)
 		return false;
 	if (binary1.texture_state != binary2.texture_state)
@@ -422,46 +430,52 @@ fragment_program_utils::fragment_program_metadata fragment_program_utils::analys
 
 usz fragment_program_utils::get_fragment_program_ucode_hash(const RSXFragmentProgram& program)
 {
-	// 64-bit Fowler/Noll/Vo FNV-1a hash code
-	usz hash = 0xCBF29CE484222325ULL;
+	// Instruction slots are gathered into a contiguous block, dropping the embedded constants, and hashed in one pass
+	thread_local std::vector<v128> instructions;
+	instructions.clear();
+	instructions.reserve(program.ucode_length / sizeof(v128));
+
 	const void* instbuffer = program.get_data();
+	const __m128i operand_type_mask = _mm_set1_epi32(0x3);
+	const __m128i constant_operand = _mm_set1_epi32(0x2);
 	usz instIndex = 0;
+
 	while (true)
 	{
 		const auto inst = v128::loadu(instbuffer, instIndex);
-		hash ^= inst._u64[0];
-		hash += (hash << 1) + (hash << 4) + (hash << 5) + (hash << 7) + (hash << 8) + (hash << 40);
-		hash ^= inst._u64[1];
-		hash += (hash << 1) + (hash << 4) + (hash << 5) + (hash << 7) + (hash << 8) + (hash << 40);
+		instructions.push_back(inst);
 		instIndex++;
-		// Skip constants
-		if (fragment_program_utils::is_constant(inst._u32[1]) ||
-			fragment_program_utils::is_constant(inst._u32[2]) ||
-			fragment_program_utils::is_constant(inst._u32[3]))
+
+		// Skip constants. Source operand types live in bits 8-9 of words 1-3
+		const __m128i operand_types = _mm_and_si128(_mm_srli_epi32(inst.vi, 8), operand_type_mask);
+		if (_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(operand_types, constant_operand))) & 0xE)
 			instIndex++;
 
 		bool end = (inst._u32[0] >> 8) & 0x1;
 		if (end)
-			return hash;
+			break;
 	}
-	return 0;
+
+	return XXH3_64bits(instructions.data(), instructions.size() * sizeof(v128));
 }
 
 usz fragment_program_storage_hash::operator()(const RSXFragmentProgram& program) const
 {
-	usz hash = fragment_program_utils::get_fragment_program_ucode_hash(program);
-	hash ^= program.ctrl;
-	hash ^= +program.two_sided_lighting;
-	hash ^= program.texture_state.texture_dimensions;
-	hash ^= program.texture_state.unnormalized_coords;
-	hash ^= program.texture_state.shadow_textures;
-	hash ^= program.texture_state.redirected_textures;
+	u64 hash = program.ucode_hash ? program.ucode_hash : fragment_program_utils::get_fragment_program_ucode_hash(program);
+	hash = rpcs3::hash64(hash, program.ctrl);
+	hash = rpcs3::hash64(hash, u32{program.two_sided_lighting});
+	hash = rpcs3::hash64(hash, program.texture_state.texture_dimensions);
+	hash = rpcs3::hash64(hash, program.texture_state.unnormalized_coords);
+	hash = rpcs3::hash64(hash, program.texture_state.shadow_textures);
+	hash = rpcs3::hash64(hash, program.texture_state.redirected_textures);
 
 	return hash;
 }
 
 bool fragment_program_compare::operator()(const RSXFragmentProgram& binary1, const RSXFragmentProgram& binary2) const
 {
+	if (binary1.ucode_hash && binary2.ucode_hash && binary1.ucode_hash != binary2.ucode_hash)
+		return false;
 	if (binary1.ctrl != binary2.ctrl || binary1.texture_state != binary2.texture_state ||
 		binary1.two_sided_lighting != binary2.two_sided_lighting)
 		return false;
@@ -489,3 +503,217 @@ bool fragment_program_compare::operator()(const RSXFragmentProgram& binary1, con
 			return true;
 	}
 }
+
+namespace rsx
+{
+	static constexpr char decompiled_cache_magic[8] = { 'R', 'P', 'C', 'S', '3', 'D', 'P', 'C' };
+	static constexpr u32 decompiled_cache_version = 4;
+
+	// Entries not looked up during this many loads of the file are dropped on the next save
+	static constexpr u32 decompiled_cache_max_unused_loads = 8;
+
+	decompiled_program_cache& decompiled_program_cache::get()
+	{
+		static decompiled_program_cache s_cache;
+		return s_cache;
+	}
+
+	u64 decompiled_program_cache::get_key(const RSXVertexProgram& prog, u64 variant)
+	{
+		u64 key = rpcs3::hash64(rpcs3::fnv_seed, variant);
+		key = rpcs3::hash64(key, static_cast<u64>(SHADER_TYPE::SHADER_TYPE_VERTEX));
+		key = rpcs3::hash64(key, prog.ucode_hash ? prog.ucode_hash : vertex_program_utils::get_vertex_program_ucode_hash(prog));
+		key = rpcs3::hash64(key, prog.output_mask);
+		key = rpcs3::hash64(key, prog.texture_state.texture_dimensions);
+
+		for (const u32 address : prog.jump_table)
+		{
+			key = rpcs3::hash64(key, address);
+		}
+
+		return key;
+	}
+
+	u64 decompiled_program_cache::get_key(const RSXFragmentProgram& prog, u64 variant)
+	{
+		u64 key = rpcs3::hash64(rpcs3::fnv_seed, variant);
+		key = rpcs3::hash64(key, static_cast<u64>(SHADER_TYPE::SHADER_TYPE_FRAGMENT));
+		key = rpcs3::hash64(key, prog.ucode_hash ? prog.ucode_hash : fragment_program_utils::get_fragment_program_ucode_hash(prog));
+		key = rpcs3::hash64(key, prog.ctrl);
+		key = rpcs3::hash64(key, u32{prog.two_sided_lighting});
+		key = rpcs3::hash64(key, prog.texcoord_control_mask);
+		key = rpcs3::hash64(key, prog.texture_state.texture_dimensions);
+		key = rpcs3::hash64(key, prog.texture_state.unnormalized_coords);
+		key = rpcs3::hash64(key, prog.texture_state.shadow_textures);
+		key = rpcs3::hash64(key, prog.texture_state.redirected_textures);
+		return key;
+	}
+
+	std::shared_ptr<const decompiled_program_cache::entry> decompiled_program_cache::find(u64 key) const
+	{
+		reader_lock lock(m_mutex);
+
+		if (const auto found = m_entries.find(key); found != m_entries.end())
+		{
+			found->second.unused_loads.release(0);
+			return found->second.value;
+		}
+
+		return {};
+	}
+
+	void decompiled_program_cache::insert(u64 key, std::string source, std::vector<u8> metadata)
+	{
+		auto value = std::make_shared<const entry>(entry{ std::move(source), std::move(metadata) });
+
+		std::lock_guard lock(m_mutex);
+
+		if (m_entries.try_emplace(key, std::move(value), 0).second)
+		{
+			m_dirty = true;
+		}
+	}
+
+	void decompiled_program_cache::load(const std::string& path)
+	{
+		std::lock_guard lock(m_mutex);
+
+		if (m_path == path)
+		{
+			return;
+		}
+
+		m_entries.clear();
+		m_path = path;
+		m_dirty = false;
+
+		fs::file f(path);
+		if (!f)
+		{
+			return;
+		}
+
+		utils::serial ar;
+		ar.set_reading_state(f.to_vector<u8>());
+
+		const auto is_readable = [&](usz size)
+		{
+			return ar.data.size() - ar.pos >= size;
+		};
+
+		char magic[8]{};
+		u32 version = 0;
+		std::string build;
+
+		if (is_readable(sizeof(magic) + sizeof(version) + sizeof(u32)))
+		{
+			ar.raw_serialize(magic, sizeof(magic));
+			ar(version);
+
+			if (const u32 build_length = ar; is_readable(build_length))
+			{
+				build.assign(reinterpret_cast<const char*>(ar.data.data() + ar.pos), build_length);
+				ar.pos += build_length;
+			}
+		}
+
+		if (std::memcmp(magic, decompiled_cache_magic, sizeof(magic)) != 0 || version != decompiled_cache_version)
+		{
+			rsx_log.warning("Ignoring incompatible decompiled program cache %s", path);
+			return;
+		}
+
+		if (build != rpcs3::get_version().to_string())
+		{
+			// The sources were generated by another build, the decompilers may have changed since
+			rsx_log.notice("Discarding decompiled program cache %s created by build '%s'", path, build);
+			fs::remove_file(path);
+			return;
+		}
+
+		while (is_readable(sizeof(u64) + sizeof(u32) * 3))
+		{
+			const u64 key = ar;
+			const u32 unused_loads = ar;
+			const u32 source_length = ar;
+			const u32 metadata_length = ar;
+
+			if (!is_readable(usz{source_length} + metadata_length))
+			{
+				rsx_log.warning("Decompiled program cache %s is truncated", path);
+				break;
+			}
+
+			auto value = std::make_shared<entry>();
+			value->source.assign(reinterpret_cast<const char*>(ar.data.data() + ar.pos), source_length);
+			value->metadata.assign(ar.data.data() + ar.pos + source_length, ar.data.data() + ar.pos + source_length + metadata_length);
+			ar.pos += usz{source_length} + metadata_length;
+
+			if (unused_loads >= decompiled_cache_max_unused_loads)
+			{
+				// Not used in a while, drop it on the next save
+				m_dirty = true;
+				continue;
+			}
+
+			m_entries.try_emplace(key, std::move(value), unused_loads + 1);
+		}
+
+		// Ages changed even if nothing gets added
+		m_dirty |= !m_entries.empty();
+
+		rsx_log.notice("Loaded %u decompiled programs from %s", m_entries.size(), path);
+	}
+
+	void decompiled_program_cache::save()
+	{
+		std::lock_guard lock(m_mutex);
+		save_unlocked();
+	}
+
+	void decompiled_program_cache::clear()
+	{
+		std::lock_guard lock(m_mutex);
+
+		// Nothing decompiled this session is lost, the next load reads it back
+		save_unlocked();
+
+		m_entries.clear();
+		m_path.clear();
+		m_dirty = false;
+	}
+
+	void decompiled_program_cache::save_unlocked()
+	{
+		if (m_path.empty() || !m_dirty)
+		{
+			return;
+		}
+
+		utils::serial ar;
+		ar.raw_serialize(decompiled_cache_magic, sizeof(decompiled_cache_magic));
+		ar(decompiled_cache_version);
+
+		const std::string build = rpcs3::get_version().to_string();
+		ar(::size32(build));
+		ar.raw_serialize(build.data(), build.size());
+
+		for (const auto& [key, cached] : m_entries)
+		{
+			const auto& value = cached.value;
+			ar(key, cached.unused_loads.load(), ::size32(value->source), ::size32(value->metadata));
+			ar.raw_serialize(value->source.data(), value->source.size());
+			ar.raw_serialize(value->metadata.data(), value->metadata.size());
+		}
+
+		fs::pending_file temp(m_path);
+
+		if (!temp.file || (temp.file.write(ar.data), !temp.commit()))
+		{
+			rsx_log.error("Failed to write decompiled program cache %s (%s)", m_path, fs::g_tls_error);
+			return;
+		}
+
+		m_dirty = false;
+	}
+}
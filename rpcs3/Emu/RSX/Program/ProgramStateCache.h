@@ -7,6 +7,7 @@
 #include "util/logs.hpp"
 #include "util/fnv_hash.hpp"
 
+#include <memory>
 #include <span>
 #include <unordered_map>
 
@@ -79,6 +80,62 @@ namespace program_hash_util
 	};
 }
 
+namespace rsx
+{
+	/**
+	 * Process-wide store of decompiler output, shared by all backends.
+	 * Entries hold the generated source and whatever program metadata the backend extracted during decompilation, keyed by
+	 * the ucode hash, the control bits the decompiler depends on and a backend/device variant. When persisted alongside the
+	 * shader cache, programs translated in a previous session are not decompiled again.
+	 */
+	class decompiled_program_cache
+	{
+	public:
+		struct entry
+		{
+			std::string source;
+			std::vector<u8> metadata;
+		};
+
+		static decompiled_program_cache& get();
+
+		static u64 get_key(const RSXVertexProgram& prog, u64 variant);
+		static u64 get_key(const RSXFragmentProgram& prog, u64 variant);
+
+		std::shared_ptr<const entry> find(u64 key) const;
+		void insert(u64 key, std::string source, std::vector<u8> metadata);
+
+		// Bind to a file on disk, replacing the current contents with what it holds.
+		// Files written by a different emulator build are discarded since the decompilers may have changed.
+		void load(const std::string& path);
+
+		// Write back to the bound file if anything was added since it was loaded
+		void save();
+
+		// Save, then drop all entries and unbind from the file
+		void clear();
+
+	private:
+		struct cached_entry
+		{
+			std::shared_ptr<const entry> value;
+			mutable atomic_t<u32> unused_loads; // Loads of the file since the entry was last looked up
+
+			cached_entry(std::shared_ptr<const entry> value, u32 unused_loads)
+				: value(std::move(value)), unused_loads(unused_loads)
+			{
+			}
+		};
+
+		void save_unlocked();
+
+		mutable shared_mutex m_mutex;
+		std::unordered_map<u64, cached_entry> m_entries;
+		std::string m_path;
+		bool m_dirty = false;
+	};
+}
+
 
 /**
 * Cache for program help structure (blob, string...)
@@ -143,10 +200,17 @@ protected:
 	shared_mutex m_decompiler_mutex;
 
 	atomic_t<usz> m_next_id = 0;
+	atomic_t<u32> m_compiles_this_frame = 0;
 	bool m_cache_miss_flag; // Set if last lookup did not find any usable cached programs
 
 	binary_to_vertex_program m_vertex_shader_cache;
 	binary_to_fragment_program m_fragment_shader_cache;
+
+	// Last program seen at each ucode address along with its storage fingerprint.
+	// Lets a program that did not change since the previous lookup be validated by a single compare.
+	std::unordered_map<u32, std::pair<u64, vertex_program_type*>> m_vertex_fast_lookup;
+	std::unordered_map<u32, std::pair<u64, fragment_program_type*>> m_fragment_fast_lookup;
+
 	std::unordered_map<pipeline_key, pipeline_storage_type, pipeline_key_hash, pipeline_key_compare> m_storage;
 
 	decompiler_callback_t notify_pipeline_compiled;
@@ -160,12 +224,28 @@ protected:
 	{
 		bool recompile = false;
 		vertex_program_type* new_shader;
+		const u64 fingerprint = program_hash_util::vertex_program_storage_hash{}(rsx_vp);
 		{
 			reader_lock lock(m_vertex_mutex);
 
+			// Vertex inputs are not part of the fingerprint, only programs that ignore them can skip the full compare
+			if (rsx_vp.skip_vertex_input_check)
+			{
+				const auto found = m_vertex_fast_lookup.find(rsx_vp.entry);
+				if (found != m_vertex_fast_lookup.end() && found->second.first == fingerprint)
+				{
+					return std::forward_as_tuple(*found->second.second, true);
+				}
+			}
+
 			const auto& I = m_vertex_shader_cache.find(rsx_vp);
 			if (I != m_vertex_shader_cache.end())
 			{
+				if (lock.try_upgrade())
+				{
+					m_vertex_fast_lookup[rsx_vp.entry] = { fingerprint, &I->second };
+				}
+
 				return std::forward_as_tuple(I->second, true);
 			}
 
@@ -180,11 +260,14 @@ protected:
 			auto [it, inserted] = m_vertex_shader_cache.try_emplace(rsx_vp);
 			new_shader = &(it->second);
 			recompile = inserted;
+
+			m_vertex_fast_lookup[rsx_vp.entry] = { fingerprint, new_shader };
 		}
 
 		if (recompile)
 		{
 			backend_traits::recompile_vertex_program(rsx_vp, *new_shader, m_next_id++);
+			m_compiles_this_frame++;
 		}
 
 		return std::forward_as_tuple(*new_shader, false);
@@ -196,13 +279,25 @@ protected:
 		bool recompile = false;
 		typename binary_to_fragment_program::iterator it;
 		fragment_program_type* new_shader;
+		const u64 fingerprint = program_hash_util::fragment_program_storage_hash{}(rsx_fp);
 
 		{
 			reader_lock lock(m_fragment_mutex);
 
+			const auto found = m_fragment_fast_lookup.find(rsx_fp.offset);
+			if (found != m_fragment_fast_lookup.end() && found->second.first == fingerprint)
+			{
+				return std::forward_as_tuple(*found->second.second, true);
+			}
+
 			const auto& I = m_fragment_shader_cache.find(rsx_fp);
 			if (I != m_fragment_shader_cache.end())
 			{
+				if (lock.try_upgrade())
+				{
+					m_fragment_fast_lookup[rsx_fp.offset] = { fingerprint, &I->second };
+				}
+
 				return std::forward_as_tuple(I->second, true);
 			}
 
@@ -216,12 +311,15 @@ protected:
 			lock.upgrade();
 			std::tie(it, recompile) = m_fragment_shader_cache.try_emplace(rsx_fp);
 			new_shader = &(it->second);
+
+			m_fragment_fast_lookup[rsx_fp.offset] = { fingerprint, new_shader };
 		}
 
 		if (recompile)
 		{
 			it->first.clone_data();
 			backend_traits::recompile_fragment_program(rsx_fp, *new_shader, m_next_id++);
+			m_compiles_this_frame++;
 		}
 
 		return std::forward_as_tuple(*new_shader, false);
@@ -302,6 +400,12 @@ public:
 	~program_state_cache()
 	{}
 
+	// Returns the number of shaders compiled since the last call
+	u32 pop_compile_count()
+	{
+		return m_compiles_this_frame.exchange(0);
+	}
+
 	template<typename... Args>
 	pipeline_type* get_graphics_pipeline(
 		const RSXVertexProgram& vertexShader,
@@ -332,6 +436,16 @@ public:
 			if (const auto I = m_storage.find(key); I != m_storage.end())
 			{
 				m_cache_miss_flag = (I->second == __null_pipeline_handle);
+
+				if (m_cache_miss_flag)
+				{
+					// Still being compiled, let the backend know it is wanted for this frame
+					if constexpr (requires { backend_traits::touch_pending_pipeline(vertex_program, fragment_program, pipelineProperties); })
+					{
+						backend_traits::touch_pending_pipeline(vertex_program, fragment_program, pipelineProperties);
+					}
+				}
+
 				return I->second.get();
 			}
 		}
@@ -407,6 +521,10 @@ public:
 		notify_pipeline_compiled = {};
 		m_fragment_shader_cache.clear();
 		m_vertex_shader_cache.clear();
+		m_fragment_fast_lookup.clear();
+		m_vertex_fast_lookup.clear();
 		m_storage.clear();
+
+		rsx::decompiled_program_cache::get().clear();
 	}
 };
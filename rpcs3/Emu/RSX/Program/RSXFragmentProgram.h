@@ -303,6 +303,9 @@ struct RSXFragmentProgram
 	bool two_sided_lighting = false;
 	u32 texcoord_control_mask = 0;
 
+	// Cached result of get_fragment_program_ucode_hash, 0 if not computed yet
+	u64 ucode_hash = 0;
+
 	rsx::fragment_program_texture_state texture_state;
 	rsx::fragment_program_texture_config texture_params;
 
@@ -18,9 +18,31 @@ namespace program_common
 			COMPILER_OPT_ENABLE_FLOW_CTRL = 512,
 			COMPILER_OPT_ENABLE_PACKING = 1024,
 			COMPILER_OPT_ENABLE_KIL = 2048,
-			COMPILER_OPT_ENABLE_STIPPLING = 4096
+			COMPILER_OPT_ENABLE_STIPPLING = 4096,
+			COMPILER_OPT_ENABLE_TEXTURE_1D = 8192,
+			COMPILER_OPT_ENABLE_TEXTURE_2D = 16384,
+			COMPILER_OPT_ENABLE_TEXTURE_CUBE = 32768,
+			COMPILER_OPT_ENABLE_TEXTURE_3D = 65536,
+			COMPILER_OPT_ENABLE_TWO_SIDED_LIGHTING = 131072,
+
+			COMPILER_OPT_TEXTURE_TYPE_MASK = COMPILER_OPT_ENABLE_TEXTURE_1D | COMPILER_OPT_ENABLE_TEXTURE_2D | COMPILER_OPT_ENABLE_TEXTURE_CUBE | COMPILER_OPT_ENABLE_TEXTURE_3D
 		};
 
+		// Sampler types the interpreter variant has to handle, from the extended dimensions of the referenced textures
+		static u64 get_texture_type_options(u32 referenced_textures_mask, u32 texture_dimensions)
+		{
+			u64 result = 0;
+			for (u32 index = 0; referenced_textures_mask; referenced_textures_mask >>= 1, ++index)
+			{
+				if (referenced_textures_mask & 1)
+				{
+					result |= u64{COMPILER_OPT_ENABLE_TEXTURE_1D} << ((texture_dimensions >> (index * 2)) & 0x3);
+				}
+			}
+
+			return result;
+		}
+
 		static std::string get_vertex_interpreter()
 		{
 			const char* s =
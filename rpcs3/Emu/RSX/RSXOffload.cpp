@@ -7,6 +7,7 @@
 
 #include <thread>
 #include "util/asm.hpp"
+#include "util/sysinfo.hpp"
 
 namespace rsx
 {
@@ -17,77 +18,161 @@ namespace rsx
 		atomic_t<u64> m_processed_count = 0;
 		transport_packet* m_current_job = nullptr;
 
-		std::thread::id m_thread_id;
+		void operator ()();
 
-		void operator ()()
+		// Waits until the work a fenced packet depends on has retired on every worker
+		static void wait_for_dependencies(const transport_packet& job);
+
+		u64 get_backlog() const
+		{
+			return m_enqueued_count.load() - m_processed_count.load();
+		}
+	};
+
+	static u32 get_offload_worker_count()
+	{
+		if (!g_cfg.video.multithreaded_rsx)
 		{
-			if (!g_cfg.video.multithreaded_rsx)
+			return 1;
+		}
+
+		// Leave most host threads to the emulated CPUs and the RSX thread itself
+		return std::clamp(utils::get_thread_count() / 4, 1u, dma_manager::max_workers);
+	}
+
+	struct dma_manager::offload_pool
+	{
+		named_thread_group<offload_thread> workers{ "RSX Offloader ", get_offload_worker_count() };
+
+		offload_thread& get(u32 index)
+		{
+			return *(workers.begin() + index);
+		}
+
+		// Independent work goes to the worker with the shortest backlog
+		offload_thread& select()
+		{
+			offload_thread* result = &get(0);
+
+			for (u32 i = 1; i < workers.size() && result->get_backlog(); ++i)
 			{
-				// Abort if disabled
-				return;
+				if (auto& worker = get(i); worker.get_backlog() < result->get_backlog())
+				{
+					result = &worker;
+				}
 			}
 
-			m_thread_id = std::this_thread::get_id();
+			return *result;
+		}
 
-			if (g_cfg.core.thread_scheduler != thread_scheduler_mode::os)
+		// Fenced work is always queued on the first worker so that it retires in submission order
+		offload_thread& select_fenced(std::array<u64, max_workers>& wait_counts)
+		{
+			for (u32 i = 0; i < workers.size(); ++i)
 			{
-				thread_ctrl::set_thread_affinity_mask(thread_ctrl::get_affinity_mask(thread_class::rsx));
+				wait_counts[i] = get(i).m_enqueued_count.load();
 			}
 
-			while (thread_ctrl::state() != thread_state::aborting)
+			return get(0);
+		}
+
+		template <typename... Args>
+		void push(offload_thread& worker, Args&&... args)
+		{
+			worker.m_enqueued_count++;
+			worker.m_work_queue.push(std::forward<Args>(args)...);
+		}
+	};
+
+	static thread_local dma_manager::offload_thread* g_tls_offload_worker = nullptr;
+
+	void dma_manager::offload_thread::operator ()()
+	{
+		if (!g_cfg.video.multithreaded_rsx)
+		{
+			// Abort if disabled
+			return;
+		}
+
+		g_tls_offload_worker = this;
+
+		if (g_cfg.core.thread_scheduler != thread_scheduler_mode::os)
+		{
+			thread_ctrl::set_thread_affinity_mask(thread_ctrl::get_affinity_mask(thread_class::rsx));
+		}
+
+		while (thread_ctrl::state() != thread_state::aborting)
+		{
+			for (auto&& job : m_work_queue.pop_all())
 			{
-				for (auto&& job : m_work_queue.pop_all())
+				m_current_job = &job;
+
+				if (job.fenced)
 				{
-					m_current_job = &job;
-
-					switch (job.type)
-					{
-					case raw_copy:
-					{
-						std::memcpy(job.dst, job.src, job.length);
-						break;
-					}
-					case vector_copy:
-					{
-						std::memcpy(job.dst, job.opt_storage.data(), job.length);
-						break;
-					}
-					case index_emulate:
-					{
-						write_index_array_for_non_indexed_non_native_primitive_to_buffer(static_cast<char*>(job.dst), static_cast<rsx::primitive_type>(job.aux_param0), job.length);
-						break;
-					}
-					case callback:
-					{
-						rsx::get_current_renderer()->renderctl(job.aux_param0, job.src);
-						break;
-					}
-					default: fmt::throw_exception("Unreachable");
-					}
-
-					m_processed_count.release(m_processed_count + 1);
+					wait_for_dependencies(job);
 				}
 
-				m_current_job = nullptr;
-
-				if (m_enqueued_count.load() == m_processed_count.load())
+				switch (job.type)
+				{
+				case raw_copy:
+				{
+					std::memcpy(job.dst, job.src, job.length);
+					break;
+				}
+				case vector_copy:
+				{
+					std::memcpy(job.dst, job.opt_storage.data(), job.length);
+					break;
+				}
+				case index_emulate:
+				{
+					write_index_array_for_non_indexed_non_native_primitive_to_buffer(static_cast<char*>(job.dst), static_cast<rsx::primitive_type>(job.aux_param0), job.length);
+					break;
+				}
+				case callback:
 				{
-					m_processed_count.notify_all();
-					std::this_thread::yield();
+					rsx::get_current_renderer()->renderctl(job.aux_param0, job.src);
+					break;
 				}
+				default: fmt::throw_exception("Unreachable");
+				}
+
+				m_processed_count.release(m_processed_count + 1);
 			}
 
-			m_processed_count = -1;
-			m_processed_count.notify_all();
+			m_current_job = nullptr;
+
+			if (m_enqueued_count.load() == m_processed_count.load())
+			{
+				m_processed_count.notify_all();
+				thread_ctrl::wait_on(m_work_queue, nullptr);
+			}
 		}
 
-		static constexpr auto thread_name = "RSX Offloader"sv;
-	};
+		m_processed_count = -1;
+		m_processed_count.notify_all();
+	}
+
+	void dma_manager::offload_thread::wait_for_dependencies(const transport_packet& job)
+	{
+		auto& pool = g_fxo->get<offload_pool>();
 
+		for (u32 i = 0; i < pool.workers.size(); ++i)
+		{
+			// Exiting workers report everything as processed
+			const auto& worker = pool.get(i);
 
-	using dma_thread = named_thread<dma_manager::offload_thread>;
+			while (worker.m_processed_count.load() < job.wait_counts[i])
+			{
+				if (thread_ctrl::state() == thread_state::aborting)
+				{
+					return;
+				}
 
-	static_assert(std::is_default_constructible_v<dma_thread>);
+				utils::pause();
+			}
+		}
+	}
 
 	// initialization
 	void dma_manager::init()
@@ -103,8 +188,8 @@ namespace rsx
 		}
 		else
 		{
-			g_fxo->get<dma_thread>().m_enqueued_count++;
-			g_fxo->get<dma_thread>().m_work_queue.push(dst, src, length);
+			auto& pool = g_fxo->get<offload_pool>();
+			pool.push(pool.select(), dst, src, length);
 		}
 	}
 
@@ -116,8 +201,8 @@ namespace rsx
 		}
 		else
 		{
-			g_fxo->get<dma_thread>().m_enqueued_count++;
-			g_fxo->get<dma_thread>().m_work_queue.push(dst, src, length);
+			auto& pool = g_fxo->get<offload_pool>();
+			pool.push(pool.select(), dst, src, length);
 		}
 	}
 
@@ -131,8 +216,8 @@ namespace rsx
 		}
 		else
 		{
-			g_fxo->get<dma_thread>().m_enqueued_count++;
-			g_fxo->get<dma_thread>().m_work_queue.push(dst, primitive, count);
+			auto& pool = g_fxo->get<offload_pool>();
+			pool.push(pool.select(), dst, primitive, count);
 		}
 	}
 
@@ -141,21 +226,37 @@ namespace rsx
 	{
 		ensure(g_cfg.video.multithreaded_rsx);
 
-		g_fxo->get<dma_thread>().m_enqueued_count++;
-		g_fxo->get<dma_thread>().m_work_queue.push(request_code, args);
+		// Backend callbacks (e.g. queue submission) consume the results of all previously queued transfers
+		auto& pool = g_fxo->get<offload_pool>();
+		std::array<u64, max_workers> wait_counts{};
+		auto& worker = pool.select_fenced(wait_counts);
+		pool.push(worker, request_code, args, wait_counts);
 	}
 
 	// Synchronization
 	bool dma_manager::is_current_thread()
 	{
-		return std::this_thread::get_id() == g_fxo->get<dma_thread>().m_thread_id;
+		return g_tls_offload_worker != nullptr;
 	}
 
 	bool dma_manager::sync() const
 	{
-		auto& _thr = g_fxo->get<dma_thread>();
+		auto& pool = g_fxo->get<offload_pool>();
 
-		if (_thr.m_enqueued_count.load() <= _thr.m_processed_count.load()) [[likely]]
+		const auto is_pending = [&]()
+		{
+			for (u32 i = 0; i < pool.workers.size(); ++i)
+			{
+				if (auto& worker = pool.get(i); worker.m_enqueued_count.load() > worker.m_processed_count.load())
+				{
+					return true;
+				}
+			}
+
+			return false;
+		};
+
+		if (!is_pending()) [[likely]]
 		{
 			// Nothing to do
 			return true;
@@ -169,7 +270,7 @@ namespace rsx
 				return false;
 			}
 
-			while (_thr.m_enqueued_count.load() > _thr.m_processed_count.load())
+			while (is_pending())
 			{
 				rsxthr->on_semaphore_acquire_wait();
 				utils::pause();
@@ -177,7 +278,7 @@ namespace rsx
 		}
 		else
 		{
-			while (_thr.m_enqueued_count.load() > _thr.m_processed_count.load())
+			while (is_pending())
 				utils::pause();
 		}
 
@@ -186,13 +287,20 @@ namespace rsx
 
 	void dma_manager::join()
 	{
-		g_fxo->get<dma_thread>() = thread_state::aborting;
+		for (auto& worker : g_fxo->get<offload_pool>().workers)
+		{
+			worker = thread_state::aborting;
+		}
+
 		sync();
 	}
 
 	void dma_manager::set_mem_fault_flag()
 	{
 		ensure(is_current_thread()); // "Access denied"
+
+		// Only one worker can be in recovery at a time, the renderer tracks a single fault range
+		m_mem_fault_lock.lock();
 		m_mem_fault_flag.release(true);
 	}
 
@@ -200,12 +308,13 @@ namespace rsx
 	{
 		ensure(is_current_thread()); // "Access denied"
 		m_mem_fault_flag.release(false);
+		m_mem_fault_lock.unlock();
 	}
 
 	// Fault recovery
 	utils::address_range dma_manager::get_fault_range(bool writing)
 	{
-		const auto m_current_job = ensure(g_fxo->get<dma_thread>().m_current_job);
+		const auto m_current_job = ensure(ensure(g_tls_offload_worker)->m_current_job);
 
 		void *address = nullptr;
 		u32 range = m_current_job->length;
@@ -2,14 +2,21 @@
 
 #include "util/types.hpp"
 #include "Utilities/address_range.h"
+#include "Utilities/mutex.h"
 #include "gcm_enums.h"
 
+#include <array>
 #include <vector>
 
 namespace rsx
 {
 	class dma_manager
 	{
+	public:
+		// Upper bound on the number of offload workers
+		static constexpr u32 max_workers = 4;
+
+	private:
 		enum op
 		{
 			raw_copy = 0,
@@ -28,6 +35,11 @@ namespace rsx
 			u32 aux_param0{};
 			u32 aux_param1{};
 
+			// Dependency tag. Independent packets may run on any worker in any order relative to other workers.
+			// Fenced packets record how much work was queued on each worker and only run once all of it has retired.
+			bool fenced = false;
+			std::array<u64, max_workers> wait_counts{};
+
 			transport_packet(void *_dst, void *_src, u32 len)
 				: type(op::raw_copy), src(_src), dst(_dst), length(len)
 			{}
@@ -40,8 +52,8 @@ namespace rsx
 				: type(op::index_emulate), dst(_dst), length(len), aux_param0(static_cast<u8>(prim))
 			{}
 
-			transport_packet(u32 command, void* args)
-				: type(op::callback), src(args), aux_param0(command)
+			transport_packet(u32 command, void* args, const std::array<u64, max_workers>& _wait_counts)
+				: type(op::callback), src(args), aux_param0(command), fenced(true), wait_counts(_wait_counts)
 			{}
 
 			transport_packet(const transport_packet&) = delete;
@@ -49,6 +61,7 @@ namespace rsx
 		};
 
 		atomic_t<bool> m_mem_fault_flag = false;
+		shared_mutex m_mem_fault_lock;
 
 		// TODO: Improved benchmarks here; value determined by profiling on a Ryzen CPU, rounded to the nearest 512 bytes
 		const u32 max_immediate_transfer_size = 3584;
@@ -80,5 +93,6 @@ namespace rsx
 		static utils::address_range get_fault_range(bool writing);
 
 		struct offload_thread;
+		struct offload_pool;
 	};
 }
@@ -28,6 +28,8 @@
 #include <unordered_set>
 #include <cfenv>
 
+#include "emmintrin.h"
+
 class GSRender;
 
 #define CMD_DEBUG 0
@@ -55,7 +57,8 @@ bool serialize<rsx::frame_capture_data>(utils::serial& ar, rsx::frame_capture_da
 		return false;
 	}
 
-	return ar(o.tile_map, o.memory_map, o.memory_data_map, o.display_buffers_map, o.replay_commands, o.reg_state);
+	// Only the capture header, frames are streamed separately by frame_capture_writer
+	return ar(o.reg_state);
 }
 
 template <>
@@ -288,6 +291,41 @@ namespace rsx
 		fmt::throw_exception("RSXVertexData::GetTypeSize: Bad vertex data type (%d)!", static_cast<u8>(type));
 	}
 
+	// C32_2X2 compressed tiles store every 32-bit pixel as a 2x2 block. Rows are expanded horizontally here, the caller duplicates them vertically
+	static void expand_c32_2x2_row(u8* dst, const u8* src, u32 width)
+	{
+		u32 x = 0;
+		for (; x + 4 <= width; x += 4)
+		{
+			const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x * 4));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 8), _mm_unpacklo_epi32(v, v));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 8 + 16), _mm_unpackhi_epi32(v, v));
+		}
+
+		for (; x < width; ++x)
+		{
+			std::memcpy(dst + x * 8, src + x * 4, 4);
+			std::memcpy(dst + x * 8 + 4, src + x * 4, 4);
+		}
+	}
+
+	// Keeps the top-left pixel of every 2x2 block in a row
+	static void decimate_c32_2x2_row(u8* dst, const u8* src, u32 width)
+	{
+		u32 x = 0;
+		for (; x + 4 <= width; x += 4)
+		{
+			const __m128 a = _mm_loadu_ps(reinterpret_cast<const f32*>(src + x * 8));
+			const __m128 b = _mm_loadu_ps(reinterpret_cast<const f32*>(src + x * 8 + 16));
+			_mm_storeu_ps(reinterpret_cast<f32*>(dst + x * 4), _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+		}
+
+		for (; x < width; ++x)
+		{
+			std::memcpy(dst + x * 4, src + x * 8, 4);
+		}
+	}
+
 	void tiled_region::write(const void *src, u32 width, u32 height, u32 pitch)
 	{
 		if (!tile)
@@ -325,15 +363,9 @@ namespace rsx
 		case CELL_GCM_COMPMODE_C32_2X2:
 			for (u32 y = 0; y < height; ++y)
 			{
-				for (u32 x = 0; x < width; ++x)
-				{
-					u32 value = *reinterpret_cast<const u32*>(static_cast<const u8*>(src) + pitch * y + x * sizeof(u32));
-
-					*reinterpret_cast<u32*>(ptr + (offset_y + y * 2 + 0) * tile->pitch + offset_x + (x * 2 + 0) * sizeof(u32)) = value;
-					*reinterpret_cast<u32*>(ptr + (offset_y + y * 2 + 0) * tile->pitch + offset_x + (x * 2 + 1) * sizeof(u32)) = value;
-					*reinterpret_cast<u32*>(ptr + (offset_y + y * 2 + 1) * tile->pitch + offset_x + (x * 2 + 0) * sizeof(u32)) = value;
-					*reinterpret_cast<u32*>(ptr + (offset_y + y * 2 + 1) * tile->pitch + offset_x + (x * 2 + 1) * sizeof(u32)) = value;
-				}
+				u8* dst_row = ptr + (offset_y + y * 2) * tile->pitch + offset_x;
+				expand_c32_2x2_row(dst_row, static_cast<const u8*>(src) + pitch * y, width);
+				std::memcpy(dst_row + tile->pitch, dst_row, width * 8);
 			}
 			break;
 		default:
@@ -377,12 +409,7 @@ namespace rsx
 		case CELL_GCM_COMPMODE_C32_2X2:
 			for (u32 y = 0; y < height; ++y)
 			{
-				for (u32 x = 0; x < width; ++x)
-				{
-					u32 value = *reinterpret_cast<u32*>(ptr + (offset_y + y * 2 + 0) * tile->pitch + offset_x + (x * 2 + 0) * sizeof(u32));
-
-					*reinterpret_cast<u32*>(static_cast<u8*>(dst) + pitch * y + x * sizeof(u32)) = value;
-				}
+				decimate_c32_2x2_row(static_cast<u8*>(dst) + pitch * y, ptr + (offset_y + y * 2) * tile->pitch + offset_x, width);
 			}
 			break;
 		default:
@@ -449,8 +476,12 @@ namespace rsx
 				// The backend guarantees that any draw calls emitted during this time will NOT generate any ROP writes
 				ensure(!cond_render_ctrl.hw_cond_active);
 
-				// Pending evaluation, use hardware test
-				begin_conditional_rendering(cond_render_ctrl.eval_sources);
+				// Sources read back early since the evaluation was requested no longer hold host query data
+				if (!cond_render_ctrl.fold_resolved_sources(this))
+				{
+					// Pending evaluation, use hardware test
+					begin_conditional_rendering(cond_render_ctrl.eval_sources);
+				}
 			}
 			else
 			{
@@ -728,6 +759,8 @@ namespace rsx
 
 		m_rsx_thread_exiting = true;
 		g_fxo->get<rsx::dma_manager>().join();
+
+		flush_frame_statistics();
 		state += cpu_flag::exit;
 	}
 
@@ -1590,6 +1623,7 @@ namespace rsx
 		current_fragment_program.ucode_length = current_fp_metadata.program_ucode_length;
 		current_fragment_program.total_length = current_fp_metadata.program_ucode_length + current_fp_metadata.program_start_offset;
 		current_fragment_program.texture_state.import(current_fp_texture_state, current_fp_metadata.referenced_textures_mask);
+		current_fragment_program.ucode_hash = program_hash_util::fragment_program_utils::get_fragment_program_ucode_hash(current_fragment_program);
 		current_fragment_program.valid = true;
 
 		if (!(m_graphics_state & rsx::pipeline_state::fragment_program_state_dirty))
@@ -1630,6 +1664,7 @@ namespace rsx
 		);
 
 		current_vertex_program.texture_state.import(current_vp_texture_state, current_vp_metadata.referenced_textures_mask);
+		current_vertex_program.ucode_hash = program_hash_util::vertex_program_utils::get_vertex_program_ucode_hash(current_vertex_program);
 
 		if (!(m_graphics_state & rsx::pipeline_state::vertex_program_state_dirty))
 		{
@@ -2369,9 +2404,85 @@ namespace rsx
 		if (info.emu_flip)
 		{
 			performance_counters.sampled_frames++;
+
+			if (m_profiler.enabled || m_has_frame_statistics_listener)
+			{
+				record_frame_statistics(info.stats);
+			}
 		}
 	}
 
+	void thread::set_frame_statistics_listener(std::function<void(const frame_statistics_t&)> listener)
+	{
+		std::lock_guard lock(m_frame_statistics_listener_mutex);
+
+		m_has_frame_statistics_listener = !!listener;
+		m_frame_statistics_listener = std::move(listener);
+	}
+
+	void thread::record_frame_statistics(const frame_statistics_t& stats)
+	{
+		m_last_frame_stats = stats;
+		m_frame_stats_window.frame_index++;
+
+		if (m_has_frame_statistics_listener)
+		{
+			reader_lock lock(m_frame_statistics_listener_mutex);
+
+			if (m_frame_statistics_listener)
+			{
+				m_frame_statistics_listener(stats);
+			}
+		}
+
+		if (!g_cfg.video.perf_overlay.frame_stats_csv)
+		{
+			flush_frame_statistics();
+			m_frame_stats_window.csv.close();
+			return;
+		}
+
+		if (!m_frame_stats_window.csv)
+		{
+			if (m_frame_stats_window.csv_failed)
+			{
+				return;
+			}
+
+			const std::string file_path = fs::get_config_dir() + "captures/" + Emu.GetTitleID() + "_" + date_time::current_time_narrow() + "_frame_stats.csv";
+
+			if (!m_frame_stats_window.csv.open(file_path, fs::rewrite))
+			{
+				rsx_log.error("Failed to create frame statistics file: %s (%s)", file_path, fs::g_tls_error);
+				m_frame_stats_window.csv_failed = true;
+				return;
+			}
+
+			rsx_log.notice("Writing frame statistics to %s", file_path);
+			m_frame_stats_window.csv_buffer = "frame,timestamp_us,draw_calls,gpu_us,fifo_us,setup_us,vertex_upload_us,texture_upload_us,draw_exec_us,flip_us,flip_wait_us,zcull_stalls,zcull_stall_us,zcull_speculative,zcull_misses\n";
+		}
+
+		fmt::append(m_frame_stats_window.csv_buffer, "%llu,%llu,%u,%lld,%lld,%lld,%lld,%lld,%lld,%lld,%lld,%u,%lld,%u,%u\n",
+			m_frame_stats_window.frame_index, get_system_time(), stats.draw_calls, stats.gpu_time, stats.fifo_time, stats.setup_time,
+			stats.vertex_upload_time, stats.textures_upload_time, stats.draw_exec_time, stats.flip_time, stats.flip_wait_time,
+			stats.zcull_sync_stalls, stats.zcull_sync_stall_time, stats.zcull_speculative_reports, stats.zcull_speculation_misses);
+
+		if (m_frame_stats_window.csv_buffer.size() >= 0x10000)
+		{
+			flush_frame_statistics();
+		}
+	}
+
+	void thread::flush_frame_statistics()
+	{
+		if (m_frame_stats_window.csv && !m_frame_stats_window.csv_buffer.empty())
+		{
+			m_frame_stats_window.csv.write(m_frame_stats_window.csv_buffer);
+		}
+
+		m_frame_stats_window.csv_buffer.clear();
+	}
+
 	void thread::check_zcull_status(bool framebuffer_swap)
 	{
 		if (framebuffer_swap)
@@ -2446,13 +2557,14 @@ namespace rsx
 		auto result = zcull_ctrl->find_query(ref, true);
 		if (result.found)
 		{
-			if (!result.queries.empty())
+			if (!result.queries.empty() && !result.raw_zpass_result)
 			{
 				cond_render_ctrl.set_eval_sources(result.queries);
 				sync_hint(FIFO_hint::hint_conditional_render_eval, cond_render_ctrl.eval_sources.front());
 			}
 			else
 			{
+				// Either nothing is left to test on the host or an early readback already passed the test
 				bool failed = (result.raw_zpass_result == 0);
 				cond_render_ctrl.set_eval_result(this, failed);
 			}
@@ -2838,7 +2950,8 @@ namespace rsx
 		if (!performance_counters.last_update_timestamp || performance_counters.sampled_frames > 30)
 		{
 			const auto timestamp = get_system_time();
-			const auto idle = performance_counters.idle_time.load();
+			const auto idle_total = performance_counters.idle_time.load();
+			const auto idle = idle_total - performance_counters.last_update_idle_time;
 			const auto elapsed = timestamp - performance_counters.last_update_timestamp;
 
 			if (elapsed > idle)
@@ -2846,7 +2959,7 @@ namespace rsx
 			else
 				performance_counters.approximate_load = 0u;
 
-			performance_counters.idle_time = 0;
+			performance_counters.last_update_idle_time = idle_total;
 			performance_counters.sampled_frames = 0;
 			performance_counters.last_update_timestamp = timestamp;
 		}
@@ -2857,46 +2970,61 @@ namespace rsx
 	void thread::on_frame_end(u32 buffer, bool forced)
 	{
 		// Marks the end of a frame scope GPU-side
-		if (g_user_asked_for_frame_capture.exchange(false) && !capture_current_frame)
+		const auto begin_capture_frame = [this]()
 		{
-			capture_current_frame = true;
-			frame_debug.reset();
-			frame_capture.reset();
-
-			// random number just to jumpstart the size
-			frame_capture.replay_commands.reserve(8000);
-
 			// capture first tile state with nop cmd
 			rsx::frame_capture_data::replay_command replay_cmd;
 			replay_cmd.rsx_command = std::make_pair(NV4097_NO_OPERATION, 0);
 			frame_capture.replay_commands.push_back(replay_cmd);
 			capture::capture_display_tile_state(this, frame_capture.replay_commands.back());
-		}
-		else if (capture_current_frame)
-		{
-			capture_current_frame = false;
+		};
 
+		if (g_user_asked_for_frame_capture.exchange(false) && !capture_current_frame)
+		{
 			const std::string file_path = fs::get_config_dir() + "captures/" + Emu.GetTitleID() + "_" + date_time::current_time_narrow() + "_capture.rrc";
 
-			// todo: may want to compress this data?
-			utils::serial save_manager;
-			save_manager.reserve(0x800'0000); // 128MB
-
-			save_manager(frame_capture);
-
-			fs::pending_file temp(file_path);
+			frame_debug.reset();
+			frame_capture.reset();
 
-			if (temp.file && (temp.file.write(save_manager.data), temp.commit(false)))
+			if (capture_writer.open(file_path, frame_capture))
 			{
-				rsx_log.success("Capture successful: %s", file_path);
+				capture_current_frame = true;
+				capture_frames_remaining = g_cfg.video.capture_frame_count;
+
+				// random number just to jumpstart the size
+				frame_capture.replay_commands.reserve(8000);
+				begin_capture_frame();
 			}
 			else
 			{
 				rsx_log.fatal("Capture failed: %s (%s)", file_path, fs::g_tls_error);
 			}
+		}
+		else if (capture_current_frame)
+		{
+			// Each frame is compressed and written out as it completes, only entries not yet in the file are kept
+			const bool written = capture_writer.write_frame(frame_capture);
 
-			frame_capture.reset();
-			Emu.Pause();
+			if (written && --capture_frames_remaining)
+			{
+				begin_capture_frame();
+			}
+			else
+			{
+				capture_current_frame = false;
+
+				if (written && capture_writer.commit())
+				{
+					rsx_log.success("Capture successful: %s (%u frames)", capture_writer.get_path(), capture_writer.get_frame_count());
+				}
+				else
+				{
+					rsx_log.fatal("Capture failed: %s (%s)", capture_writer.get_path(), fs::g_tls_error);
+				}
+
+				frame_capture.reset();
+				Emu.Pause();
+			}
 		}
 
 		if (zcull_ctrl->has_pending())
@@ -2908,6 +3036,38 @@ namespace rsx
 			zcull_ctrl->clear(this, CELL_GCM_ZPASS_PIXEL_CNT | CELL_GCM_ZCULL_STATS);
 		}
 
+		if (m_profiler.enabled)
+		{
+			// Whatever busy time the measured stages do not account for was spent decoding the FIFO and handling methods
+			const u64 timestamp = get_system_time();
+			const u64 idle_time = performance_counters.idle_time.load();
+
+			if (m_frame_stats_window.timestamp)
+			{
+				const s64 busy_time = static_cast<s64>(timestamp - m_frame_stats_window.timestamp) - static_cast<s64>(idle_time - m_frame_stats_window.idle_time);
+				const s64 stage_time = m_frame_stats.setup_time + m_frame_stats.vertex_upload_time + m_frame_stats.textures_upload_time +
+					m_frame_stats.draw_exec_time + m_frame_stats.flip_time;
+
+				m_frame_stats.fifo_time = std::max<s64>(busy_time - stage_time, 0);
+			}
+
+			m_frame_stats_window.timestamp = timestamp;
+			m_frame_stats_window.idle_time = idle_time;
+		}
+		else
+		{
+			m_frame_stats_window.timestamp = 0;
+		}
+
+		// Cache and compiler counters are kept by the backend and reset on flip
+		get_backend_frame_statistics(m_frame_stats);
+
+		const auto zcull_stats = zcull_ctrl->pop_statistics();
+		m_frame_stats.zcull_sync_stalls = zcull_stats.sync_stalls;
+		m_frame_stats.zcull_sync_stall_time = zcull_stats.sync_stall_time;
+		m_frame_stats.zcull_speculative_reports = zcull_stats.speculative_writes;
+		m_frame_stats.zcull_speculation_misses = zcull_stats.speculation_misses;
+
 		// Save current state
 		m_queued_flip.stats = m_frame_stats;
 		m_queued_flip.push(buffer);
@@ -2948,7 +3108,8 @@ namespace rsx
 
 		// Reset current stats
 		m_frame_stats = {};
-		m_profiler.enabled = !!g_cfg.video.overlay;
+		m_profiler.enabled = g_cfg.video.overlay || g_cfg.video.perf_overlay.frame_stats_csv || m_has_frame_statistics_listener ||
+			(g_cfg.video.perf_overlay.perf_overlay_enabled && g_cfg.video.perf_overlay.level == detail_level::high);
 	}
 
 	void thread::request_emu_flip(u32 buffer)
@@ -3027,6 +3188,7 @@ namespace rsx
 					}
 
 					performance_counters.idle_time += delay_us;
+					m_queued_flip.stats.flip_wait_time = delay_us;
 				}
 			}
 		}
@@ -3251,6 +3413,7 @@ namespace rsx
 					m_current_task->result = 0;
 					m_current_task->active = true;
 					m_current_task->owned = false;
+					m_current_task->resolved = false;
 					m_current_task->sync_tag = 0;
 					m_current_task->timestamp = 0;
 
@@ -3377,6 +3540,16 @@ namespace rsx
 				// No other queries in the chain, write result
 				const auto value = (writer->type == CELL_GCM_ZPASS_PIXEL_CNT) ? m_statistics_map[writer->counter_tag] : result;
 				write(writer, ptimer->timestamp(), value);
+
+				if (writer->type == CELL_GCM_ZPASS_PIXEL_CNT)
+				{
+					if (writer->speculated && writer->predicted_visible != (value != 0))
+					{
+						m_sync_statistics.speculation_misses++;
+					}
+
+					m_last_report_visibility[writer->sink] = (value != 0);
+				}
 			}
 
 			if (writer->query && writer->query->sync_tag == ptimer->cond_render_ctrl.eval_sync_tag)
@@ -3399,7 +3572,100 @@ namespace rsx
 			}
 		}
 
-		void ZCULL_control::sync(::rsx::thread* ptimer)
+		bool ZCULL_control::collect_query_result(queued_report_write* writer, u32& result, bool wait)
+		{
+			const auto query = writer->query;
+			const bool implemented = (writer->type == CELL_GCM_ZPASS_PIXEL_CNT || writer->type == CELL_GCM_ZCULL_STATS3);
+
+			if (!implemented || result || !query->num_draws)
+			{
+				// Already have a hit or nothing to test, no need to read the result
+				if (!query->resolved)
+				{
+					discard_occlusion_query(query);
+				}
+
+				return true;
+			}
+
+			if (!query->resolved)
+			{
+				if (check_occlusion_query_status(query))
+				{
+					get_occlusion_query_result(query);
+				}
+				else if (wait)
+				{
+					// The host is not done with this query yet, this read stalls the RSX thread
+					const u64 start = get_system_time();
+					get_occlusion_query_result(query);
+
+					m_sync_statistics.sync_stalls++;
+					m_sync_statistics.sync_stall_time += get_system_time() - start;
+				}
+				else
+				{
+					// Too early
+					return false;
+				}
+
+				query->resolved = true;
+			}
+
+			if (query->result)
+			{
+				result += query->result;
+				if (query->data_type & CELL_GCM_ZPASS_PIXEL_CNT)
+				{
+					m_statistics_map[writer->counter_tag] += query->result;
+				}
+			}
+
+			return true;
+		}
+
+		void ZCULL_control::resolve_available_queries()
+		{
+			for (auto& writer : m_pending_writes)
+			{
+				const auto query = writer.query;
+				if (!query || query->resolved || !query->num_draws)
+				{
+					continue;
+				}
+
+				if (!check_occlusion_query_status(query))
+				{
+					// Queries complete in submission order, the ones behind this are not ready either
+					break;
+				}
+
+				get_occlusion_query_result(query);
+				query->resolved = true;
+			}
+		}
+
+		void ZCULL_control::speculate(::rsx::thread* ptimer, queued_report_write* writer)
+		{
+			if (writer->speculated || writer->forwarder || writer->type != CELL_GCM_ZPASS_PIXEL_CNT)
+			{
+				// Forwarded reports are written by the last writer in their chain
+				return;
+			}
+
+			// Repeat the last visibility seen at this address. Unknown reports are predicted visible, which at worst draws something that should have been culled
+			const auto counter = m_statistics_map.find(writer->counter_tag);
+			const auto last = m_last_report_visibility.find(writer->sink);
+			const bool visible = (counter != m_statistics_map.end() && counter->second) || last == m_last_report_visibility.end() || last->second;
+
+			write(writer, ptimer->timestamp(), visible ? 1u : 0u);
+
+			writer->speculated = true;
+			writer->predicted_visible = visible;
+			m_sync_statistics.speculative_writes++;
+		}
+
+		void ZCULL_control::sync(::rsx::thread* ptimer, bool force_wait)
 		{
 			if (!m_pending_writes.empty())
 			{
@@ -3419,7 +3685,17 @@ namespace rsx
 				}
 
 				u32 processed = 0;
-				const bool has_unclaimed = (m_pending_writes.back().sink == 0);
+				bool speculating = false;
+				bool allow_speculation = !force_wait && g_cfg.video.speculative_zcull_reports.get();
+
+				if (allow_speculation)
+				{
+					// Only pixel count reports can be predicted. Any other claimed report must be written now, which requires retiring everything ahead of it
+					allow_speculation = std::none_of(m_pending_writes.cbegin(), m_pending_writes.cend(), [](const queued_report_write& writer)
+					{
+						return writer.sink && !writer.forwarder && writer.type != CELL_GCM_ZPASS_PIXEL_CNT;
+					});
+				}
 
 				// Write all claimed reports unconditionally
 				for (auto &writer : m_pending_writes)
@@ -3427,6 +3703,13 @@ namespace rsx
 					if (!writer.sink)
 						break;
 
+					if (speculating)
+					{
+						// Reports behind a speculated one stay queued to keep retirement ordered
+						speculate(ptimer, &writer);
+						continue;
+					}
+
 					auto query = writer.query;
 					u32 result = m_statistics_map[writer.counter_tag];
 
@@ -3434,24 +3717,12 @@ namespace rsx
 					{
 						ensure(query->pending);
 
-						const bool implemented = (writer.type == CELL_GCM_ZPASS_PIXEL_CNT || writer.type == CELL_GCM_ZCULL_STATS3);
-						if (implemented && !result && query->num_draws)
+						if (!collect_query_result(&writer, result, !allow_speculation))
 						{
-							get_occlusion_query_result(query);
-
-							if (query->result)
-							{
-								result += query->result;
-								if (query->data_type & CELL_GCM_ZPASS_PIXEL_CNT)
-								{
-									m_statistics_map[writer.counter_tag] += query->result;
-								}
-							}
-						}
-						else
-						{
-							//Already have a hit, no need to retest
-							discard_occlusion_query(query);
+							// Publish a prediction instead of stalling, the real value is written when the query retires
+							speculating = true;
+							speculate(ptimer, &writer);
+							continue;
 						}
 
 						free_query(query);
@@ -3461,35 +3732,35 @@ namespace rsx
 					processed++;
 				}
 
-				if (!has_unclaimed)
-				{
-					ensure(processed == m_pending_writes.size());
-					m_pending_writes.clear();
-				}
-				else
+				if (processed)
 				{
-					auto remaining = m_pending_writes.size() - processed;
-					ensure(remaining > 0);
-
+					const auto remaining = m_pending_writes.size() - processed;
 					if (remaining == 1)
 					{
 						m_pending_writes[0] = std::move(m_pending_writes.back());
 						m_pending_writes.resize(1);
 					}
-					else
+					else if (remaining)
 					{
 						std::move(m_pending_writes.begin() + processed, m_pending_writes.end(), m_pending_writes.begin());
 						m_pending_writes.resize(remaining);
 					}
+					else
+					{
+						m_pending_writes.clear();
+					}
 				}
 
-				//Delete all statistics caches but leave the current one
-				for (auto It = m_statistics_map.begin(); It != m_statistics_map.end(); )
+				if (m_pending_writes.empty() || !m_pending_writes.front().sink)
 				{
-					if (It->first == m_statistics_tag_id)
-						++It;
-					else
-						It = m_statistics_map.erase(It);
+					//Delete all statistics caches but leave the current one
+					for (auto It = m_statistics_map.begin(); It != m_statistics_map.end(); )
+					{
+						if (It->first == m_statistics_tag_id)
+							++It;
+						else
+							It = m_statistics_map.erase(It);
+					}
 				}
 
 				//Decrement jobs counter
@@ -3540,6 +3811,9 @@ namespace rsx
 					// Schedule ahead
 					m_next_tsc = m_tsc + min_zcull_tick_us;
 
+					// Read back everything the host has finished in one pass so that later syncs do not have to wait on it
+					resolve_available_queries();
+
 					// Schedule a queue flush if needed
 					if (!g_cfg.video.relaxed_zcull_sync &&
 						front.query && front.query->num_draws && front.query->sync_tag > m_sync_tag)
@@ -3586,56 +3860,10 @@ namespace rsx
 				{
 					ensure(query->pending);
 
-					const bool implemented = (writer.type == CELL_GCM_ZPASS_PIXEL_CNT || writer.type == CELL_GCM_ZCULL_STATS3);
-					if (force_read)
+					if (!collect_query_result(&writer, result, force_read))
 					{
-						if (implemented && !result && query->num_draws)
-						{
-							get_occlusion_query_result(query);
-
-							if (query->result)
-							{
-								result += query->result;
-								if (query->data_type & CELL_GCM_ZPASS_PIXEL_CNT)
-								{
-									m_statistics_map[writer.counter_tag] += query->result;
-								}
-							}
-						}
-						else
-						{
-							//No need to read this
-							discard_occlusion_query(query);
-						}
-					}
-					else
-					{
-						if (implemented && !result && query->num_draws)
-						{
-							//Maybe we get lucky and results are ready
-							if (check_occlusion_query_status(query))
-							{
-								get_occlusion_query_result(query);
-								if (query->result)
-								{
-									result += query->result;
-									if (query->data_type & CELL_GCM_ZPASS_PIXEL_CNT)
-									{
-										m_statistics_map[writer.counter_tag] += query->result;
-									}
-								}
-							}
-							else
-							{
-								//Too early; abort
-								break;
-							}
-						}
-						else
-						{
-							//Not necessary to read the result anymore
-							discard_occlusion_query(query);
-						}
+						//Too early; abort
+						break;
 					}
 
 					free_query(query);
@@ -3751,6 +3979,19 @@ namespace rsx
 			query_search_result result{};
 			u32 stat_id = 0;
 
+			const auto add_source = [&](occlusion_query_info* query)
+			{
+				if (query->resolved)
+				{
+					// Already read back ahead of retirement, the backend no longer holds any data for it
+					result.raw_zpass_result += query->result;
+				}
+				else
+				{
+					result.queries.push_back(query);
+				}
+			};
+
 			for (auto It = m_pending_writes.crbegin(); It != m_pending_writes.crend(); ++It)
 			{
 				if (stat_id) [[unlikely]]
@@ -3770,7 +4011,7 @@ namespace rsx
 					if (It->query && It->query->num_draws)
 					{
 						result.found = true;
-						result.queries.push_back(It->query);
+						add_source(It->query);
 
 						if (!all)
 						{
@@ -3783,7 +4024,7 @@ namespace rsx
 					if (It->query && It->query->num_draws)
 					{
 						result.found = true;
-						result.queries.push_back(It->query);
+						add_source(It->query);
 
 						if (!all)
 						{
@@ -3870,6 +4111,29 @@ namespace rsx
 			eval_sync_tag = eval_sources.front()->sync_tag;
 		}
 
+		bool conditional_render_eval::fold_resolved_sources(::rsx::thread* pthr)
+		{
+			u32 result = 0;
+			const auto removed = std::erase_if(eval_sources, [&](const occlusion_query_info* query)
+			{
+				if (!query->resolved)
+				{
+					return false;
+				}
+
+				result += query->result;
+				return true;
+			});
+
+			if (result || (removed && eval_sources.empty()))
+			{
+				set_eval_result(pthr, result == 0);
+				return true;
+			}
+
+			return false;
+		}
+
 		void conditional_render_eval::set_eval_result(::rsx::thread* pthr, bool failed)
 		{
 			if (hw_cond_active)
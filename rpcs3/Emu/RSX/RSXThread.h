@@ -360,6 +360,7 @@ namespace rsx
 			bool pending;
 			bool active;
 			bool owned;
+			bool resolved; // Result was read back from the host ahead of retirement
 		};
 
 		struct queued_report_write
@@ -371,6 +372,17 @@ namespace rsx
 
 			vm::addr_t sink;                      // Memory location of the report
 			std::vector<vm::addr_t> sink_alias;   // Aliased memory addresses
+
+			bool speculated = false;              // A predicted value was written ahead of the query result
+			bool predicted_visible = false;
+		};
+
+		struct zcull_statistics
+		{
+			u32 sync_stalls = 0;        // Query results the RSX thread had to wait on the host GPU for
+			s64 sync_stall_time = 0;    // Time spent in those waits
+			u32 speculative_writes = 0; // Reports written with a predicted value
+			u32 speculation_misses = 0; // Predicted reports later corrected to a different visibility
 		};
 
 		struct query_search_result
@@ -421,6 +433,10 @@ namespace rsx
 			std::vector<queued_report_write> m_pending_writes{};
 			std::unordered_map<u32, u32> m_statistics_map{};
 
+			// Last retired visibility of each report address, used to predict speculative reports
+			std::unordered_map<u32, bool> m_last_report_visibility{};
+			zcull_statistics m_sync_statistics{};
+
 			// Enables/disables the ZCULL unit
 			void set_active(class ::rsx::thread* ptimer, bool state, bool flush_queue);
 
@@ -440,6 +456,15 @@ namespace rsx
 			// Retire operation
 			void retire(class ::rsx::thread* ptimer, queued_report_write* writer, u32 result);
 
+			// Adds the result of a retiring query to its report. Returns false if the result is not available and wait is not set
+			bool collect_query_result(queued_report_write* writer, u32& result, bool wait);
+
+			// Reads back every query result the host has already made available, oldest first
+			void resolve_available_queries();
+
+			// Writes a predicted value for a report whose query result is not available yet
+			void speculate(class ::rsx::thread* ptimer, queued_report_write* writer);
+
 		public:
 
 			ZCULL_control();
@@ -457,8 +482,8 @@ namespace rsx
 			// Clears current stat block and increments stat_tag_id
 			void clear(class ::rsx::thread* ptimer, u32 type);
 
-			// Forcefully flushes all
-			void sync(class ::rsx::thread* ptimer);
+			// Forcefully flushes all. Reports may be speculated instead unless force_wait is set
+			void sync(class ::rsx::thread* ptimer, bool force_wait = false);
 
 			// Conditionally sync any pending writes if range overlaps
 			flags32_t read_barrier(class ::rsx::thread* ptimer, u32 memory_address, u32 memory_range, flags32_t flags);
@@ -476,6 +501,9 @@ namespace rsx
 			// Check for pending writes
 			bool has_pending() const { return !m_pending_writes.empty(); }
 
+			// Returns and resets the synchronization statistics gathered since the last call
+			zcull_statistics pop_statistics() { return std::exchange(m_sync_statistics, {}); }
+
 			// Search for query synchronized at address
 			query_search_result find_query(vm::addr_t sink_address, bool all);
 
@@ -520,6 +548,9 @@ namespace rsx
 			// Sets data sources for predicate evaluation
 			void set_eval_sources(std::vector<occlusion_query_info*>& sources);
 
+			// Drops sources whose results were already read back. Returns true if these decided the evaluation.
+			bool fold_resolved_sources(thread* pthr);
+
 			// Sets evaluation result. Result is true if conditional evaluation failed
 			void set_eval_result(thread* pthr, bool failed);
 
@@ -536,6 +567,16 @@ namespace rsx
 		s64 textures_upload_time;
 		s64 draw_exec_time;
 		s64 flip_time;
+		s64 fifo_time;      // RSX thread busy time not covered by the other stages (FIFO decode, method handling)
+		s64 flip_wait_time; // Time spent in the frame limiter before the flip
+		s64 gpu_time;       // Host GPU execution time of the most recently retired frame, 0 if unavailable
+		u32 texture_uploads;       // Texture cache upload requests
+		u32 texture_upload_misses; // Upload requests that had to be served from CPU memory
+		u32 shader_compiles;       // Vertex and fragment programs compiled by the backend
+		u32 zcull_sync_stalls;     // ZCULL query results the RSX thread had to wait for
+		s64 zcull_sync_stall_time;
+		u32 zcull_speculative_reports;
+		u32 zcull_speculation_misses;
 	};
 
 	struct display_flip_info_t
@@ -641,6 +682,26 @@ namespace rsx
 		// Profiler
 		rsx::profiling_timer m_profiler;
 		frame_statistics_t m_frame_stats;
+		frame_statistics_t m_last_frame_stats{};
+
+		struct
+		{
+			u64 timestamp = 0;  // Time of the last frame boundary
+			u64 idle_time = 0;  // Idle counter at the last frame boundary
+			u64 frame_index = 0;
+			fs::file csv;
+			std::string csv_buffer;
+			bool csv_failed = false;
+		}
+		m_frame_stats_window;
+
+		// Set from the capture replay thread while the RSX thread may be presenting
+		shared_mutex m_frame_statistics_listener_mutex;
+		std::function<void(const frame_statistics_t&)> m_frame_statistics_listener;
+		atomic_t<bool> m_has_frame_statistics_listener = false;
+
+		void record_frame_statistics(const frame_statistics_t& stats);
+		void flush_frame_statistics();
 
 	public:
 		RsxDmaControl* ctrl = nullptr;
@@ -665,8 +726,9 @@ namespace rsx
 		// Performance approximation counters
 		struct
 		{
-			atomic_t<u64> idle_time{ 0 };  // Time spent idling in microseconds
+			atomic_t<u64> idle_time{ 0 };  // Time spent idling in microseconds, never reset
 			u64 last_update_timestamp = 0; // Timestamp of last load update
+			u64 last_update_idle_time = 0; // Idle counter at the last load update
 			u64 FIFO_idle_timestamp = 0;   // Timestamp of when FIFO queue becomes idle
 			FIFO_state state = FIFO_state::running;
 			u32 approximate_load = 0;
@@ -776,6 +838,8 @@ namespace rsx
 		vm::ptr<void(u32)> vblank_handler = vm::null;
 		atomic_t<u64> vblank_count{0};
 		bool capture_current_frame = false;
+		u32 capture_frames_remaining = 0;
+		frame_capture_writer capture_writer;
 
 	public:
 		atomic_t<bool> sync_point_request = false;
@@ -827,6 +891,7 @@ namespace rsx
 
 		virtual void on_init_thread() = 0;
 		virtual void on_frame_end(u32 buffer, bool forced = false);
+		virtual void get_backend_frame_statistics(frame_statistics_t& /*stats*/) {}
 		virtual void flip(const display_flip_info_t& info) = 0;
 		virtual u64 timestamp();
 		virtual bool on_access_violation(u32 /*address*/, bool /*is_writing*/) { return false; }
@@ -955,6 +1020,12 @@ namespace rsx
 		// Get RSX approximate load in %
 		u32 get_load();
 
+		// Statistics of the last presented emulated frame
+		const frame_statistics_t& get_last_frame_stats() const { return m_last_frame_stats; }
+
+		// Receives the statistics of every presented emulated frame while set (capture replay benchmark). Returns once no call to the previous listener is in progress
+		void set_frame_statistics_listener(std::function<void(const frame_statistics_t&)> listener);
+
 		// Returns true if the current thread is the active RSX thread
 		bool is_current_thread() const { return std::this_thread::get_id() == m_rsx_thread; }
 	};
@@ -1,5 +1,10 @@
 #include "stdafx.h"
 #include "VKCommonDecompiler.h"
+#include "Utilities/File.h"
+#include "Utilities/mutex.h"
+#include "util/fnv_hash.hpp"
+
+#include "xxhash.h"
 
 #ifdef _MSC_VER
 #pragma warning(push, 0)
@@ -25,6 +30,40 @@ namespace vk
 {
 	static TBuiltInResource g_default_config;
 
+	struct spirv_cache
+	{
+		static constexpr char magic[8] = { 'R', 'P', 'C', 'S', '3', 'S', 'P', 'V' };
+		static constexpr u32 version = 1;
+
+		struct record_header
+		{
+			u64 key;
+			u32 length;               // In words
+			u32 checksum;
+		};
+
+		shared_mutex mutex;
+		std::unordered_map<u64, std::vector<u32>> entries;
+		std::string path;
+		bool dirty = false;
+
+		static u64 get_key(const std::string& source, program_domain domain)
+		{
+			u64 key = XXH3_64bits(source.data(), source.size());
+			key = rpcs3::hash64(key, source.size());
+			key = rpcs3::hash64(key, static_cast<u32>(domain));
+			key = rpcs3::hash64(key, static_cast<u32>(glslang::GetSpirvGeneratorVersion()));
+			return key;
+		}
+
+		static u32 get_checksum(const std::vector<u32>& spv)
+		{
+			return static_cast<u32>(XXH3_64bits(spv.data(), spv.size() * sizeof(u32)));
+		}
+	};
+
+	static spirv_cache g_spirv_cache;
+
 	void init_default_resources(TBuiltInResource &rsc)
 	{
 		rsc.maxLights = 32;
@@ -157,6 +196,18 @@ namespace vk
 
 	bool compile_glsl_to_spv(std::string& shader, program_domain domain, std::vector<u32>& spv)
 	{
+		const u64 cache_key = spirv_cache::get_key(shader, domain);
+
+		{
+			reader_lock lock(g_spirv_cache.mutex);
+
+			if (const auto found = g_spirv_cache.entries.find(cache_key); found != g_spirv_cache.entries.end())
+			{
+				spv = found->second;
+				return true;
+			}
+		}
+
 		EShLanguage lang = (domain == glsl_fragment_program) ? EShLangFragment :
 			(domain == glsl_vertex_program)? EShLangVertex : EShLangCompute;
 
@@ -198,9 +249,106 @@ namespace vk
 			rsx_log.error("%s", shader_object.getInfoDebugLog());
 		}
 
+		if (success)
+		{
+			std::lock_guard lock(g_spirv_cache.mutex);
+
+			if (g_spirv_cache.entries.emplace(cache_key, spv).second)
+			{
+				g_spirv_cache.dirty = true;
+			}
+		}
+
 		return success;
 	}
 
+	void load_spirv_cache(const std::string& path)
+	{
+		std::lock_guard lock(g_spirv_cache.mutex);
+
+		if (g_spirv_cache.path == path)
+		{
+			return;
+		}
+
+		g_spirv_cache.entries.clear();
+		g_spirv_cache.path = path;
+		g_spirv_cache.dirty = false;
+
+		const auto data = fs::file(path).to_vector<u8>();
+
+		u32 version = 0;
+		if (data.size() >= sizeof(spirv_cache::magic) + sizeof(u32))
+		{
+			std::memcpy(&version, data.data() + sizeof(spirv_cache::magic), sizeof(u32));
+		}
+
+		if (!version || std::memcmp(data.data(), spirv_cache::magic, sizeof(spirv_cache::magic)) != 0 || version != spirv_cache::version)
+		{
+			return;
+		}
+
+		usz offset = sizeof(spirv_cache::magic) + sizeof(u32);
+
+		while (offset + sizeof(spirv_cache::record_header) <= data.size())
+		{
+			spirv_cache::record_header header;
+			std::memcpy(&header, data.data() + offset, sizeof(header));
+			offset += sizeof(header);
+
+			if (data.size() - offset < usz{header.length} * sizeof(u32))
+			{
+				break;
+			}
+
+			std::vector<u32> spv(header.length);
+			std::memcpy(spv.data(), data.data() + offset, spv.size() * sizeof(u32));
+			offset += spv.size() * sizeof(u32);
+
+			if (spirv_cache::get_checksum(spv) != header.checksum)
+			{
+				rsx_log.warning("SPIR-V cache %s is damaged, discarding the remaining entries", path);
+				break;
+			}
+
+			g_spirv_cache.entries.emplace(header.key, std::move(spv));
+		}
+
+		rsx_log.notice("Loaded %u SPIR-V modules from %s", g_spirv_cache.entries.size(), path);
+	}
+
+	void save_spirv_cache()
+	{
+		std::lock_guard lock(g_spirv_cache.mutex);
+
+		if (g_spirv_cache.path.empty() || !g_spirv_cache.dirty)
+		{
+			return;
+		}
+
+		fs::pending_file temp(g_spirv_cache.path);
+
+		if (temp.file)
+		{
+			temp.file.write(spirv_cache::magic, sizeof(spirv_cache::magic));
+			temp.file.write(spirv_cache::version);
+
+			for (const auto& [key, spv] : g_spirv_cache.entries)
+			{
+				temp.file.write(spirv_cache::record_header{ key, ::size32(spv), spirv_cache::get_checksum(spv) });
+				temp.file.write(spv);
+			}
+		}
+
+		if (!temp.file || !temp.commit())
+		{
+			rsx_log.error("Failed to write SPIR-V cache %s (%s)", g_spirv_cache.path, fs::g_tls_error);
+			return;
+		}
+
+		g_spirv_cache.dirty = false;
+	}
+
 	void initialize_compiler_context()
 	{
 		glslang::InitializeProcess();
@@ -10,4 +10,8 @@ namespace vk
 
 	void initialize_compiler_context();
 	void finalize_compiler_context();
+
+	// Compiled SPIR-V is kept keyed by the GLSL source and the glslang version, optionally backed by a file
+	void load_spirv_cache(const std::string& path);
+	void save_spirv_cache();
 }
@@ -991,7 +991,7 @@ void VKGSRender::end()
 		{
 			// Force flush
 			rsx_log.error("[Performance Warning] Out of free occlusion slots. Forcing hard sync.");
-			ZCULL_control::sync(this);
+			ZCULL_control::sync(this, true);
 
 			occlusion_id = m_occlusion_query_manager->allocate_query(*m_current_command_buffer);
 			if (occlusion_id == umax)
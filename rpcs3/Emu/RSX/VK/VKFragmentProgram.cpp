@@ -5,8 +5,11 @@
 #include "vkutils/device.h"
 #include "Emu/system_config.h"
 #include "../Program/GLSLCommon.h"
+#include "../Program/ProgramStateCache.h"
 #include "../GCM.h"
 
+#include "util/serialization.hpp"
+
 std::string VKFragmentDecompilerThread::getFloatTypeName(usz elementCount)
 {
 	return glsl::getFloatTypeNameImpl(elementCount);
@@ -403,24 +406,50 @@ void VKFragmentProgram::Decompile(const RSXFragmentProgram& prog)
 
 	decompiler.device_props.emulate_depth_compare = !pdev->get_formats_support().d24_unorm_s8;
 	decompiler.device_props.has_low_precision_rounding = vk::get_driver_vendor() == vk::driver_vendor::NVIDIA;
-	decompiler.Task();
 
-	shader.create(::glsl::program_domain::glsl_fragment_program, source);
+	auto& cache = rsx::decompiled_program_cache::get();
+	const u64 variant = rpcs3::hash64(rpcs3::hash_struct(pdev->get_pipeline_binding_table()), (u64{0x564b4650} << 32) | // 'VKFP'
+		(u64{decompiler.device_props.has_native_half_support} << 0) |
+		(u64{decompiler.device_props.emulate_depth_compare} << 1) |
+		(u64{decompiler.device_props.has_low_precision_rounding} << 2) |
+		(u64{g_cfg.video.antialiasing_level == msaa_level::none} << 3));
+	const u64 key = cache.get_key(prog, variant);
 
-	for (const ParamType& PT : decompiler.m_parr.params[PF_PARAM_UNIFORM])
+	if (const auto cached = cache.find(key))
 	{
-		for (const ParamItem& PI : PT.items)
-		{
-			if (PT.type == "sampler1D" ||
-				PT.type == "sampler2D" ||
-				PT.type == "sampler3D" ||
-				PT.type == "samplerCube")
-				continue;
+		source = cached->source;
 
-			usz offset = atoi(PI.name.c_str() + 2);
-			FragmentConstantOffsetCache.push_back(offset);
+		utils::serial ar;
+		ar.set_reading_state(std::vector<u8>(cached->metadata));
+		ar(FragmentConstantOffsetCache, output_color_masks);
+		vk::glsl::deserialize_program_inputs(ar, uniforms);
+	}
+	else
+	{
+		decompiler.Task();
+
+		for (const ParamType& PT : decompiler.m_parr.params[PF_PARAM_UNIFORM])
+		{
+			for (const ParamItem& PI : PT.items)
+			{
+				if (PT.type == "sampler1D" ||
+					PT.type == "sampler2D" ||
+					PT.type == "sampler3D" ||
+					PT.type == "samplerCube")
+					continue;
+
+				usz offset = atoi(PI.name.c_str() + 2);
+				FragmentConstantOffsetCache.push_back(offset);
+			}
 		}
+
+		utils::serial ar;
+		ar(FragmentConstantOffsetCache, output_color_masks);
+		vk::glsl::serialize_program_inputs(ar, uniforms);
+		cache.insert(key, source, std::move(ar.data));
 	}
+
+	shader.create(::glsl::program_domain::glsl_fragment_program, source);
 }
 
 void VKFragmentProgram::Compile()
@@ -426,6 +426,13 @@ VKGSRender::VKGSRender() : GSRender()
 	for (u32 n = 0; n < occlusion_query_count; ++n)
 		m_occlusion_query_data[n].driver_handle = n;
 
+	//Frame timing
+	if (const auto& limits = m_device->gpu().get_limits(); limits.timestampComputeAndGraphics)
+	{
+		m_frame_timing_pool = std::make_unique<vk::query_pool>(*m_device, VK_QUERY_TYPE_TIMESTAMP, frame_timing_slots * 2);
+		m_timestamp_period = limits.timestampPeriod;
+	}
+
 	//Generate frame contexts
 	const auto& binding_table = m_device->get_pipeline_binding_table();
 	const u32 num_fs_samplers = binding_table.vertex_textures_first_bind_slot - binding_table.textures_first_bind_slot;
@@ -499,7 +506,7 @@ VKGSRender::VKGSRender() : GSRender()
 	if (g_cfg.video.disable_vertex_cache || g_cfg.video.multithreaded_rsx)
 		m_vertex_cache = std::make_unique<vk::null_vertex_cache>();
 	else
-		m_vertex_cache = std::make_unique<vk::weak_vertex_cache>();
+		m_vertex_cache = std::make_unique<vk::persistent_vertex_cache>();
 
 	m_shaders_cache = std::make_unique<vk::shader_cache>(*m_prog_buffer, "vulkan", "v1.91");
 
@@ -622,6 +629,8 @@ VKGSRender::~VKGSRender()
 
 	//Shaders
 	vk::destroy_pipe_compiler();      // Ensure no pending shaders being compiled
+	vk::destroy_pipeline_cache();     // Write back the driver pipeline cache
+	vk::save_spirv_cache();
 	vk::finalize_compiler_context();  // Shut down the glslang compiler
 	m_prog_buffer->clear();           // Delete shader objects
 	m_shader_interpreter.destroy();
@@ -686,6 +695,7 @@ VKGSRender::~VKGSRender()
 
 	//Queries
 	m_occlusion_query_manager.reset();
+	m_frame_timing_pool.reset();
 	m_cond_render_buffer.reset();
 
 	//Command buffer
@@ -730,15 +740,28 @@ bool VKGSRender::on_access_violation(u32 address, bool is_writing)
 
 	if (result.num_flushable > 0)
 	{
+		if (!is_current_thread())
+		{
+			// If the readback already landed (speculative download), the faulting thread can write it back by itself
+			// instead of waiting for the RSX thread to reach a flush point
+			std::lock_guard lock(m_secondary_cb_guard);
+
+			if (m_texture_cache.try_flush_all_async(m_secondary_command_buffer, result))
+			{
+				return true;
+			}
+		}
+
 		if (g_fxo->get<rsx::dma_manager>().is_current_thread())
 		{
-			// The offloader thread cannot handle flush requests
+			// The offloader threads cannot handle flush requests
+			// Setting the fault flag serializes recovery between offload workers
+			g_fxo->get<rsx::dma_manager>().set_mem_fault_flag();
 			ensure(!(m_queue_status & flush_queue_state::deadlock));
 
 			m_offloader_fault_range = g_fxo->get<rsx::dma_manager>().get_fault_range(is_writing);
 			m_offloader_fault_cause = (is_writing) ? rsx::invalidation_cause::write : rsx::invalidation_cause::read;
 
-			g_fxo->get<rsx::dma_manager>().set_mem_fault_flag();
 			m_queue_status |= flush_queue_state::deadlock;
 
 			// Wait for deadlock to clear
@@ -798,6 +821,8 @@ void VKGSRender::on_invalidate_memory_range(const utils::address_range &range, r
 	auto data = m_texture_cache.invalidate_range(m_secondary_command_buffer, range, cause);
 	AUDIT(data.empty());
 
+	m_vertex_cache->invalidate_range(range);
+
 	if (cause == rsx::invalidation_cause::unmap)
 	{
 		if (data.violation_handled)
@@ -859,10 +884,15 @@ void VKGSRender::notify_tile_unbound(u32 tile)
 	}
 }
 
-void VKGSRender::check_heap_status(u32 flags)
+void VKGSRender::get_backend_frame_statistics(rsx::frame_statistics_t& stats)
 {
-	ensure(flags);
+	stats.texture_uploads = m_texture_cache.get_texture_upload_calls_this_frame();
+	stats.texture_upload_misses = m_texture_cache.get_texture_upload_misses_this_frame();
+	stats.shader_compiles = m_prog_buffer->pop_compile_count();
+}
 
+bool VKGSRender::is_heap_critical(u32 flags) const
+{
 	bool heap_critical;
 	if (flags == VK_HEAP_CHECK_ALL)
 	{
@@ -922,7 +952,26 @@ void VKGSRender::check_heap_status(u32 flags)
 		while (flags && !heap_critical);
 	}
 
-	if (heap_critical)
+	return heap_critical;
+}
+
+void VKGSRender::check_heap_status(u32 flags)
+{
+	ensure(flags);
+
+	if (!is_heap_critical(flags))
+	{
+		return;
+	}
+
+	// Release the heap segments of any frames the GPU has already retired before considering a hard wait.
+	// Segments are tagged per frame in flight, so this is usually enough to make room without stalling.
+	if (!m_queued_frames.empty() && m_current_frame != &m_aux_frame_context)
+	{
+		check_present_status();
+	}
+
+	if (is_heap_critical(flags))
 	{
 		m_profiler.start();
 
@@ -1086,6 +1135,14 @@ void VKGSRender::on_init_thread()
 	GSRender::on_init_thread();
 	zcull_ctrl.reset(static_cast<::rsx::reports::ZCULL_control*>(this));
 
+	if (const std::string cache_dir = m_shaders_cache->get_cache_directory(); !cache_dir.empty())
+	{
+		// Seed the SPIR-V and driver caches before any pipeline gets built
+		fs::create_path(cache_dir);
+		vk::load_spirv_cache(cache_dir + "spirv.bin");
+		vk::load_pipeline_cache(cache_dir + "driver_pipelines.bin");
+	}
+
 	if (!m_overlay_manager)
 	{
 		m_frame->hide();
@@ -1099,6 +1156,8 @@ void VKGSRender::on_init_thread()
 		// TODO: Handle window resize messages during loading on GPUs without OUT_OF_DATE_KHR support
 		m_shaders_cache->load(&dlg, pipeline_layout);
 	}
+
+	vk::save_spirv_cache();
 }
 
 void VKGSRender::on_exit()
@@ -1720,7 +1779,7 @@ bool VKGSRender::load_program()
 			m_interpreter_state = rsx::invalidate_pipeline_bits;
 		}
 
-		m_program = m_shader_interpreter.get(properties, current_fp_metadata);
+		m_program = m_shader_interpreter.get(properties, current_fp_metadata, current_fragment_program.texture_state.texture_dimensions);
 	}
 
 	m_pipeline_properties = properties;
@@ -2044,6 +2103,28 @@ void VKGSRender::open_command_buffer()
 	m_current_command_buffer->begin();
 }
 
+void VKGSRender::queue_surface_readback()
+{
+	// Surfaces still bound at the end of a frame are not covered by the readback issued when a surface is unbound.
+	// Start the download of those the predictor expects to be read so it completes along with the frame.
+	// A later CPU access then only needs to copy the data into guest memory (see on_access_violation).
+	if (g_cfg.video.write_color_buffers)
+	{
+		for (const auto& surface : m_surface_info)
+		{
+			if (surface.pitch)
+			{
+				m_texture_cache.flush_if_cache_miss_likely(*m_current_command_buffer, surface.get_memory_range());
+			}
+		}
+	}
+
+	if (g_cfg.video.write_depth_buffer && m_depth_surface_info.pitch)
+	{
+		m_texture_cache.flush_if_cache_miss_likely(*m_current_command_buffer, m_depth_surface_info.get_memory_range());
+	}
+}
+
 void VKGSRender::prepare_rtts(rsx::framebuffer_creation_context context)
 {
 	const bool clipped_scissor = (context == rsx::framebuffer_creation_context::context_draw);
@@ -26,6 +26,7 @@ namespace vk
 {
 	using vertex_cache = rsx::vertex_cache::default_vertex_cache<rsx::vertex_cache::uploaded_range<VkFormat>, VkFormat>;
 	using weak_vertex_cache = rsx::vertex_cache::weak_vertex_cache<VkFormat>;
+	using persistent_vertex_cache = rsx::vertex_cache::persistent_vertex_cache<VkFormat>;
 	using null_vertex_cache = vertex_cache;
 
 	using shader_cache = rsx::shaders_cache<vk::pipeline_props, vk::program_cache>;
@@ -413,6 +414,21 @@ private:
 	rsx::reports::occlusion_query_info *m_active_query_info = nullptr;
 	std::vector<vk::occlusion_data> m_occlusion_map;
 
+	// GPU frame timing. Each in-flight frame owns a begin/end timestamp query pair
+	static constexpr u32 frame_timing_slots = 4;
+	enum class frame_timing_state : u8
+	{
+		dirty = 0, // Needs a reset before reuse
+		ready,
+		pending
+	};
+
+	std::unique_ptr<vk::query_pool> m_frame_timing_pool;
+	std::array<frame_timing_state, frame_timing_slots> m_frame_timing_state = {};
+	u32 m_frame_timing_index = 0;
+	bool m_frame_timing_open = false;
+	f64 m_timestamp_period = 0.;
+
 	shared_mutex m_secondary_cb_guard;
 	vk::command_pool m_secondary_command_buffer_pool;
 	vk::command_buffer m_secondary_command_buffer;  //command buffer used for setup operations
@@ -501,6 +517,7 @@ public:
 
 private:
 	void prepare_rtts(rsx::framebuffer_creation_context context);
+	void queue_surface_readback();
 
 	void open_command_buffer();
 	void close_and_submit_command_buffer(
@@ -516,6 +533,9 @@ private:
 	void present(vk::frame_context_t *ctx);
 	void reinitialize_swapchain();
 
+	void begin_frame_timing();
+	void end_frame_timing();
+
 	vk::image* get_present_source(vk::present_surface_info* info, const rsx::avconf& avconfig);
 
 	void begin_render_pass();
@@ -524,6 +544,7 @@ private:
 
 	void update_draw_state();
 
+	bool is_heap_critical(u32 flags) const;
 	void check_heap_status(u32 flags = VK_HEAP_CHECK_ALL);
 	void check_present_status();
 
@@ -573,6 +594,7 @@ protected:
 	void on_init_thread() override;
 	void on_exit() override;
 	void flip(const rsx::display_flip_info_t& info) override;
+	void get_backend_frame_statistics(rsx::frame_statistics_t& stats) override;
 
 	void renderctl(u32 request_code, void* args) override;
 
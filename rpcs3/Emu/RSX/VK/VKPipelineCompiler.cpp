@@ -2,8 +2,10 @@
 #include "VKPipelineCompiler.h"
 #include "VKRenderPass.h"
 #include "vkutils/device.h"
+#include "Utilities/File.h"
 #include "Utilities/Thread.h"
 
+#include <map>
 #include <thread>
 
 #include "util/sysinfo.hpp"
@@ -15,6 +17,158 @@ namespace vk
 	int g_num_pipe_compilers = 0;
 	atomic_t<int> g_compiler_index{};
 
+	// Shared by all compiler threads, vkCreate*Pipelines synchronizes access internally
+	VkPipelineCache g_pipeline_cache = VK_NULL_HANDLE;
+	std::string g_pipeline_cache_path;
+
+	struct pipe_compiler::job_queue
+	{
+		// Jobs not requested by any frame for this long are parked until asked for again
+		static constexpr u64 stale_frame_count = 30;
+
+		struct order_key
+		{
+			u64 request_frame;
+			u64 sequence;
+
+			// Most recently requested first, then in submission order
+			bool operator<(const order_key& other) const
+			{
+				return request_frame != other.request_frame ? request_frame > other.request_frame : sequence < other.sequence;
+			}
+		};
+
+		shared_mutex mutex;
+		std::map<order_key, std::unique_ptr<pipe_compiler_job>> jobs;
+		std::unordered_map<u64, order_key> keyed_jobs;
+		std::unordered_map<u64, std::unique_ptr<pipe_compiler_job>> parked_jobs;
+		u64 next_sequence = 0;
+		atomic_t<u32> pending = 0;
+
+		atomic_t<u64> frame = 0;
+		atomic_t<u32> compiled = 0;
+		atomic_t<u32> coalesced = 0;
+		atomic_t<u32> parked = 0;
+		atomic_t<u64> latency_total = 0;
+		atomic_t<u64> latency_max = 0;
+		pipe_compiler_stats last_frame_stats{};
+
+		// Requires mutex
+		void enqueue(std::unique_ptr<pipe_compiler_job> job)
+		{
+			const order_key order{ job->request_frame, next_sequence++ };
+
+			if (job->key)
+			{
+				keyed_jobs[job->key] = order;
+			}
+
+			jobs.emplace(order, std::move(job));
+			pending++;
+		}
+
+		void push(std::unique_ptr<pipe_compiler_job> job)
+		{
+			job->request_frame = frame;
+			job->submit_time = steady_clock::now();
+
+			{
+				std::lock_guard lock(mutex);
+
+				if (job->key && (keyed_jobs.contains(job->key) || parked_jobs.contains(job->key)))
+				{
+					// The queued copy already carries a callback storing into the same slot
+					coalesced++;
+
+					if (!touch(job->key, job->request_frame))
+					{
+						return;
+					}
+				}
+				else
+				{
+					enqueue(std::move(job));
+				}
+			}
+
+			pending.notify_one();
+		}
+
+		// Requires mutex
+		bool touch(u64 key, u64 current_frame)
+		{
+			if (const auto found = keyed_jobs.find(key); found != keyed_jobs.end())
+			{
+				if (found->second.request_frame != current_frame)
+				{
+					auto node = jobs.extract(found->second);
+					node.key().request_frame = current_frame;
+					node.mapped()->request_frame = current_frame;
+					found->second = node.key();
+					jobs.insert(std::move(node));
+				}
+
+				return false;
+			}
+
+			if (const auto found = parked_jobs.find(key); found != parked_jobs.end())
+			{
+				auto job = std::move(found->second);
+				parked_jobs.erase(found);
+
+				job->request_frame = current_frame;
+				enqueue(std::move(job));
+				return true;
+			}
+
+			return false;
+		}
+
+		std::unique_ptr<pipe_compiler_job> pop()
+		{
+			std::lock_guard lock(mutex);
+
+			const u64 current_frame = frame;
+
+			while (!jobs.empty())
+			{
+				auto job = std::move(jobs.begin()->second);
+				jobs.erase(jobs.begin());
+				pending--;
+
+				if (job->key)
+				{
+					keyed_jobs.erase(job->key);
+
+					if (current_frame - job->request_frame > stale_frame_count)
+					{
+						// Nothing is waiting on this anymore, keep it aside in case it is needed again
+						parked++;
+						const u64 key = job->key;
+						parked_jobs.emplace(key, std::move(job));
+						continue;
+					}
+				}
+
+				return job;
+			}
+
+			return {};
+		}
+
+		void clear()
+		{
+			std::lock_guard lock(mutex);
+
+			jobs.clear();
+			keyed_jobs.clear();
+			parked_jobs.clear();
+			pending = 0;
+		}
+	};
+
+	pipe_compiler::job_queue pipe_compiler::s_job_queue;
+
 	pipe_compiler::pipe_compiler()
 	{
 		// TODO: Initialize workqueue
@@ -34,28 +188,61 @@ namespace vk
 	{
 		while (thread_ctrl::state() != thread_state::aborting)
 		{
-			for (auto&& job : m_work_queue.pop_all())
+			if (auto job = s_job_queue.pop())
 			{
-				if (job.is_graphics_job)
-				{
-					auto compiled = int_compile_graphics_pipe(job.graphics_data, job.graphics_modules, job.pipe_layout, job.inputs, {});
-					job.callback_func(compiled);
-				}
-				else
-				{
-					auto compiled = int_compile_compute_pipe(job.compute_data, job.pipe_layout);
-					job.callback_func(compiled);
-				}
+				run_job(*job);
+				continue;
 			}
 
-			thread_ctrl::wait_on(m_work_queue, nullptr);
+			thread_ctrl::wait_on(s_job_queue.pending, 0);
+		}
+	}
+
+	void pipe_compiler::run_job(pipe_compiler_job& job)
+	{
+		if (job.is_graphics_job)
+		{
+			auto compiled = int_compile_graphics_pipe(job.graphics_data, job.graphics_modules, job.pipe_layout, job.inputs, {});
+			job.callback_func(compiled);
+		}
+		else
+		{
+			auto compiled = int_compile_compute_pipe(job.compute_data, job.pipe_layout);
+			job.callback_func(compiled);
+		}
+
+		const u64 latency = std::chrono::duration_cast<std::chrono::microseconds>(steady_clock::now() - job.submit_time).count();
+		s_job_queue.compiled++;
+		s_job_queue.latency_total += latency;
+		s_job_queue.latency_max.fetch_op([&](u64& value) { value = std::max(value, latency); });
+	}
+
+	u64 pipe_compiler::get_job_key(const vk::pipeline_props& create_info, const VkShaderModule module_handles[2])
+	{
+		u64 key = rpcs3::hash_struct(create_info);
+		key = rpcs3::hash64(key, std::bit_cast<u64>(module_handles[0]));
+		key = rpcs3::hash64(key, std::bit_cast<u64>(module_handles[1]));
+		return key ? key : 1;
+	}
+
+	void pipe_compiler::touch(u64 job_key)
+	{
+		bool reactivated;
+		{
+			std::lock_guard lock(s_job_queue.mutex);
+			reactivated = s_job_queue.touch(job_key, s_job_queue.frame);
+		}
+
+		if (reactivated)
+		{
+			s_job_queue.pending.notify_one();
 		}
 	}
 
 	std::unique_ptr<glsl::program> pipe_compiler::int_compile_compute_pipe(const VkComputePipelineCreateInfo& create_info, VkPipelineLayout pipe_layout)
 	{
 		VkPipeline pipeline;
-		vkCreateComputePipelines(*g_render_device, nullptr, 1, &create_info, nullptr, &pipeline);
+		vkCreateComputePipelines(*g_render_device, g_pipeline_cache, 1, &create_info, nullptr, &pipeline);
 		return std::make_unique<vk::glsl::program>(*m_device, pipeline, pipe_layout);
 	}
 
@@ -63,7 +250,7 @@ namespace vk
 			const std::vector<glsl::program_input>& vs_inputs, const std::vector<glsl::program_input>& fs_inputs)
 	{
 		VkPipeline pipeline;
-		CHECK_RESULT(vkCreateGraphicsPipelines(*m_device, nullptr, 1, &create_info, NULL, &pipeline));
+		CHECK_RESULT(vkCreateGraphicsPipelines(*m_device, g_pipeline_cache, 1, &create_info, NULL, &pipeline));
 		auto result = std::make_unique<vk::glsl::program>(*m_device, pipeline, pipe_layout, vs_inputs, fs_inputs);
 		result->link();
 		return result;
@@ -177,7 +364,7 @@ namespace vk
 			return int_compile_compute_pipe(create_info, pipe_layout);
 		}
 
-		m_work_queue.push(create_info, pipe_layout, callback);
+		s_job_queue.push(std::make_unique<pipe_compiler_job>(create_info, pipe_layout, callback));
 		return {};
 	}
 
@@ -204,7 +391,9 @@ namespace vk
 			return int_compile_graphics_pipe(create_info, module_handles, pipe_layout, vs_inputs, fs_inputs);
 		}
 
-		m_work_queue.push(create_info, pipe_layout, module_handles, vs_inputs, fs_inputs, callback);
+		auto job = std::make_unique<pipe_compiler_job>(create_info, pipe_layout, module_handles, vs_inputs, fs_inputs, callback);
+		job->key = get_job_key(create_info, module_handles);
+		s_job_queue.push(std::move(job));
 		return {};
 	}
 
@@ -249,6 +438,96 @@ namespace vk
 	void destroy_pipe_compiler()
 	{
 		g_pipe_compilers.reset();
+		pipe_compiler::s_job_queue.clear();
+	}
+
+	void load_pipeline_cache(const std::string& path)
+	{
+		ensure(g_render_device && !g_pipeline_cache);
+
+		std::vector<u8> initial_data = fs::file(path).to_vector<u8>();
+
+		// Drivers are required to reject foreign blobs, but some crash on them instead. Only hand over data produced by this device.
+		VkPhysicalDeviceProperties props;
+		vkGetPhysicalDeviceProperties(g_render_device->gpu(), &props);
+
+		VkPipelineCacheHeaderVersionOne header{};
+		if (initial_data.size() >= sizeof(header))
+		{
+			std::memcpy(&header, initial_data.data(), sizeof(header));
+		}
+
+		if (header.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE ||
+			header.vendorID != props.vendorID ||
+			header.deviceID != props.deviceID ||
+			std::memcmp(header.pipelineCacheUUID, props.pipelineCacheUUID, VK_UUID_SIZE) != 0)
+		{
+			initial_data.clear();
+		}
+
+		VkPipelineCacheCreateInfo create_info{};
+		create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+		create_info.initialDataSize = initial_data.size();
+		create_info.pInitialData = initial_data.data();
+
+		CHECK_RESULT(vkCreatePipelineCache(*g_render_device, &create_info, nullptr, &g_pipeline_cache));
+		g_pipeline_cache_path = path;
+
+		rsx_log.notice("Pipeline cache initialized with %llu bytes from %s", initial_data.size(), path);
+	}
+
+	void destroy_pipeline_cache()
+	{
+		if (!g_pipeline_cache)
+		{
+			return;
+		}
+
+		usz size = 0;
+		std::vector<u8> data;
+
+		if (vkGetPipelineCacheData(*g_render_device, g_pipeline_cache, &size, nullptr) == VK_SUCCESS && size)
+		{
+			data.resize(size);
+
+			if (vkGetPipelineCacheData(*g_render_device, g_pipeline_cache, &size, data.data()) == VK_SUCCESS)
+			{
+				data.resize(size);
+
+				fs::pending_file temp(g_pipeline_cache_path);
+				if (!temp.file || (temp.file.write(data), !temp.commit()))
+				{
+					rsx_log.error("Failed to write pipeline cache %s (%s)", g_pipeline_cache_path, fs::g_tls_error);
+				}
+			}
+		}
+
+		vkDestroyPipelineCache(*g_render_device, g_pipeline_cache, nullptr);
+		g_pipeline_cache = VK_NULL_HANDLE;
+		g_pipeline_cache_path.clear();
+	}
+
+	void advance_pipe_compiler_frame()
+	{
+		auto& queue = pipe_compiler::s_job_queue;
+		std::lock_guard lock(queue.mutex);
+
+		auto& stats = queue.last_frame_stats;
+		stats.queue_depth = ::size32(queue.jobs);
+		stats.compiled = queue.compiled.exchange(0);
+		stats.coalesced = queue.coalesced.exchange(0);
+		stats.parked = queue.parked.exchange(0);
+		stats.avg_latency_us = stats.compiled ? queue.latency_total.exchange(0) / stats.compiled : 0;
+		stats.max_latency_us = queue.latency_max.exchange(0);
+
+		queue.frame++;
+	}
+
+	pipe_compiler_stats get_pipe_compiler_stats()
+	{
+		auto& queue = pipe_compiler::s_job_queue;
+		reader_lock lock(queue.mutex);
+		return queue.last_frame_stats;
 	}
 
 	pipe_compiler* get_pipe_compiler()
@@ -50,6 +50,16 @@ namespace vk
 		}
 	};
 
+	struct pipe_compiler_stats
+	{
+		u32 queue_depth = 0;        // Jobs waiting for a worker
+		u32 compiled = 0;           // Jobs completed during the last frame
+		u32 coalesced = 0;          // Duplicate requests merged into a queued job
+		u32 parked = 0;             // Stale jobs set aside until they are requested again
+		u64 avg_latency_us = 0;     // Mean time from submission to completion
+		u64 max_latency_us = 0;
+	};
+
 	class pipe_compiler
 	{
 	public:
@@ -89,6 +99,12 @@ namespace vk
 
 		void operator()();
 
+		// Identifies a graphics job so that duplicate requests can be merged and pending ones re-prioritized
+		static u64 get_job_key(const vk::pipeline_props& create_info, const VkShaderModule module_handles[2]);
+
+		// Signal that the current frame is still waiting on a queued job
+		static void touch(u64 job_key);
+
 	private:
 		class compute_pipeline_props : public VkComputePipelineCreateInfo
 		{
@@ -110,6 +126,10 @@ namespace vk
 			bool is_graphics_job;
 			callback_t callback_func;
 
+			u64 key = 0;                // Zero for jobs that cannot be merged
+			u64 request_frame = 0;      // Last frame that asked for the result
+			steady_clock::time_point submit_time;
+
 			vk::pipeline_props graphics_data;
 			compute_pipeline_props compute_data;
 			VkPipelineLayout pipe_layout;
@@ -148,8 +168,17 @@ namespace vk
 			}
 		};
 
+		// Jobs are shared by all workers and served most recently requested first
+		struct job_queue;
+		static job_queue s_job_queue;
+
 		const vk::render_device* m_device = nullptr;
-		lf_queue<pipe_compiler_job> m_work_queue;
+
+		void run_job(pipe_compiler_job& job);
+
+		friend void destroy_pipe_compiler();
+		friend void advance_pipe_compiler_frame();
+		friend pipe_compiler_stats get_pipe_compiler_stats();
 
 		std::unique_ptr<glsl::program> int_compile_compute_pipe(const VkComputePipelineCreateInfo& create_info, VkPipelineLayout pipe_layout);
 		std::unique_ptr<glsl::program> int_compile_graphics_pipe(const VkGraphicsPipelineCreateInfo& create_info, VkPipelineLayout pipe_layout,
@@ -161,6 +190,14 @@ namespace vk
 	void initialize_pipe_compiler(int num_worker_threads = -1);
 	void destroy_pipe_compiler();
 	pipe_compiler* get_pipe_compiler();
+
+	// Start a new frame for job prioritization and metrics
+	void advance_pipe_compiler_frame();
+	pipe_compiler_stats get_pipe_compiler_stats();
+
+	// Driver-level pipeline cache, seeded from and written back to the given file
+	void load_pipeline_cache(const std::string& path);
+	void destroy_pipeline_cache();
 }
 
 namespace rpcs3
@@ -1,6 +1,7 @@
 #include "stdafx.h"
 #include "VKGSRender.h"
 #include "vkutils/buffer_object.h"
+#include "vkutils/query_pool.hpp"
 #include "Emu/RSX/Overlays/overlays.h"
 #include "Emu/Cell/Modules/cellVideoOut.h"
 
@@ -120,7 +121,9 @@ void VKGSRender::advance_queued_frames()
 
 	vk::remove_unused_framebuffers();
 
-	m_vertex_cache->purge();
+	m_vertex_cache->on_frame_end();
+	vk::advance_pipe_compiler_frame();
+
 	m_current_frame->tag_frame_end(m_attrib_ring_info.get_current_put_pos_minus_one(),
 		m_vertex_env_ring_info.get_current_put_pos_minus_one(),
 		m_fragment_env_ring_info.get_current_put_pos_minus_one(),
@@ -142,6 +145,59 @@ void VKGSRender::advance_queued_frames()
 	vk::advance_frame_counter();
 }
 
+void VKGSRender::begin_frame_timing()
+{
+	if (!m_profiler.enabled || !m_frame_timing_pool)
+	{
+		return;
+	}
+
+	// Retire finished frames, oldest first. The slot about to be reused is the oldest one.
+	// Queries are reset as soon as they are read back so a stale result is never observed for a frame that is still in flight.
+	for (u32 n = 0; n < frame_timing_slots; ++n)
+	{
+		const u32 slot = (m_frame_timing_index + n) % frame_timing_slots;
+		if (m_frame_timing_state[slot] != frame_timing_state::pending)
+		{
+			continue;
+		}
+
+		u64 timestamps[2];
+		if (vkGetQueryPoolResults(*m_device, *m_frame_timing_pool, slot * 2, 2, sizeof(timestamps), timestamps, sizeof(u64), VK_QUERY_RESULT_64_BIT) != VK_SUCCESS)
+		{
+			break;
+		}
+
+		m_frame_stats.gpu_time = timestamps[1] > timestamps[0] ? static_cast<s64>((timestamps[1] - timestamps[0]) * m_timestamp_period / 1000.) : 0;
+
+		vkCmdResetQueryPool(*m_current_command_buffer, *m_frame_timing_pool, slot * 2, 2);
+		m_frame_timing_state[slot] = frame_timing_state::ready;
+	}
+
+	if (m_frame_timing_state[m_frame_timing_index] != frame_timing_state::ready)
+	{
+		// First use, or the GPU fell too far behind and the sample in this slot is dropped rather than stalling
+		vkCmdResetQueryPool(*m_current_command_buffer, *m_frame_timing_pool, m_frame_timing_index * 2, 2);
+	}
+
+	vkCmdWriteTimestamp(*m_current_command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, *m_frame_timing_pool, m_frame_timing_index * 2);
+	m_frame_timing_open = true;
+}
+
+void VKGSRender::end_frame_timing()
+{
+	if (!m_frame_timing_open)
+	{
+		return;
+	}
+
+	vkCmdWriteTimestamp(*m_current_command_buffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, *m_frame_timing_pool, m_frame_timing_index * 2 + 1);
+
+	m_frame_timing_state[m_frame_timing_index] = frame_timing_state::pending;
+	m_frame_timing_index = (m_frame_timing_index + 1) % frame_timing_slots;
+	m_frame_timing_open = false;
+}
+
 void VKGSRender::queue_swap_request()
 {
 	ensure(!m_current_frame->swap_command_buffer);
@@ -417,6 +473,8 @@ void VKGSRender::flip(const rsx::display_flip_info_t& info)
 		frame_context_cleanup(m_current_frame, true);
 	}
 
+	queue_surface_readback();
+
 	if (info.skip_frame || swapchain_unavailable)
 	{
 		if (!info.skip_frame)
@@ -750,6 +808,7 @@ void VKGSRender::flip(const rsx::display_flip_info_t& info)
 			m_text_writer->print_text(*m_current_command_buffer, *direct_fbo, 4,  72, direct_fbo->width(), direct_fbo->height(), fmt::format("texture upload time: %8dus", info.stats.textures_upload_time));
 			m_text_writer->print_text(*m_current_command_buffer, *direct_fbo, 4,  90, direct_fbo->width(), direct_fbo->height(), fmt::format("draw call execution: %8dus", info.stats.draw_exec_time));
 			m_text_writer->print_text(*m_current_command_buffer, *direct_fbo, 4, 108, direct_fbo->width(), direct_fbo->height(), fmt::format("submit and flip: %12dus", info.stats.flip_time));
+			m_text_writer->print_text(*m_current_command_buffer, *direct_fbo, 4, 126, direct_fbo->width(), direct_fbo->height(), fmt::format("GPU frame time: %13dus", info.stats.gpu_time));
 
 			const auto num_dirty_textures = m_texture_cache.get_unreleased_textures_count();
 			const auto texture_memory_size = m_texture_cache.get_texture_memory_in_use() / (1024 * 1024);
@@ -757,17 +816,34 @@ void VKGSRender::flip(const rsx::display_flip_info_t& info)
 			const auto num_flushes = m_texture_cache.get_num_flush_requests();
 			const auto num_mispredict = m_texture_cache.get_num_cache_mispredictions();
 			const auto num_speculate = m_texture_cache.get_num_cache_speculative_writes();
+			const auto num_async = m_texture_cache.get_num_async_flushes();
 			const auto num_misses = m_texture_cache.get_num_cache_misses();
 			const auto num_unavoidable = m_texture_cache.get_num_unavoidable_hard_faults();
 			const auto cache_miss_ratio = static_cast<u32>(ceil(m_texture_cache.get_cache_miss_ratio() * 100));
 			const auto num_texture_upload = m_texture_cache.get_texture_upload_calls_this_frame();
 			const auto num_texture_upload_miss = m_texture_cache.get_texture_upload_misses_this_frame();
 			const auto texture_upload_miss_ratio = m_texture_cache.get_texture_upload_miss_percentage();
+			const auto num_texture_upload_skip = m_texture_cache.get_texture_upload_skips_this_frame();
 			m_text_writer->print_text(*m_current_command_buffer, *direct_fbo, 4, 144, direct_fbo->width(), direct_fbo->height(), fmt::format("Unreleased textures: %8d", num_dirty_textures));
 			m_text_writer->print_text(*m_current_command_buffer, *direct_fbo, 4, 162, direct_fbo->width(), direct_fbo->height(), fmt::format("Texture cache memory: %7dM", texture_memory_size));
 			m_text_writer->print_text(*m_current_command_buffer, *direct_fbo, 4, 180, direct_fbo->width(), direct_fbo->height(), fmt::format("Temporary texture memory: %3dM", tmp_texture_memory_size));
-			m_text_writer->print_text(*m_current_command_buffer, *direct_fbo, 4, 198, direct_fbo->width(), direct_fbo->height(), fmt::format("Flush requests: %13d  = %2d (%3d%%) hard faults, %2d unavoidable, %2d misprediction(s), %2d speculation(s)", num_flushes, num_misses, cache_miss_ratio, num_unavoidable, num_mispredict, num_speculate));
-			m_text_writer->print_text(*m_current_command_buffer, *direct_fbo, 4, 216, direct_fbo->width(), direct_fbo->height(), fmt::format("Texture uploads: %14u (%u from CPU - %02u%%)", num_texture_upload, num_texture_upload_miss, texture_upload_miss_ratio));
+			m_text_writer->print_text(*m_current_command_buffer, *direct_fbo, 4, 198, direct_fbo->width(), direct_fbo->height(), fmt::format("Flush requests: %13d  = %2d (%3d%%) hard faults, %2d unavoidable, %2d misprediction(s), %2d speculation(s), %2d async", num_flushes, num_misses, cache_miss_ratio, num_unavoidable, num_mispredict, num_speculate, num_async));
+			m_text_writer->print_text(*m_current_command_buffer, *direct_fbo, 4, 216, direct_fbo->width(), direct_fbo->height(), fmt::format("Texture uploads: %14u (%u from CPU - %02u%%, %u unchanged)", num_texture_upload, num_texture_upload_miss, texture_upload_miss_ratio, num_texture_upload_skip));
+
+			const auto texture_memory_usage = m_texture_cache.get_texture_memory_usage();
+			const auto num_evictions = m_texture_cache.get_num_evictions_last_frame();
+			m_text_writer->print_text(*m_current_command_buffer, *direct_fbo, 4, 234, direct_fbo->width(), direct_fbo->height(), fmt::format("Texture memory usage: %6uM sampled, %uM blit src, %uM blit dst, %uM framebuffer, %uM unreleased, %u evicted last frame",
+				texture_memory_usage.shader_read / 0x100000, texture_memory_usage.blit_engine_src / 0x100000, texture_memory_usage.blit_engine_dst / 0x100000,
+				texture_memory_usage.framebuffer_storage / 0x100000, texture_memory_usage.unreleased / 0x100000, num_evictions));
+
+			const auto compiler_stats = vk::get_pipe_compiler_stats();
+			m_text_writer->print_text(*m_current_command_buffer, *direct_fbo, 4, 252, direct_fbo->width(), direct_fbo->height(), fmt::format("Pipeline queue: %13u (%u compiled, %u merged, %u parked, %lluus avg, %lluus max)",
+				compiler_stats.queue_depth, compiler_stats.compiled, compiler_stats.coalesced, compiler_stats.parked, compiler_stats.avg_latency_us, compiler_stats.max_latency_us));
+
+			const auto heap_peak = [](const vk::data_heap& heap) { return static_cast<u32>(heap.get_peak_usage() * 100 / heap.size()); };
+			m_text_writer->print_text(*m_current_command_buffer, *direct_fbo, 4, 270, direct_fbo->width(), direct_fbo->height(), fmt::format("Heap peak usage: %14u%% vertex, %u%% index, %u%% texture upload, %u%% transform constants, %u%% fragment constants%s",
+				heap_peak(m_attrib_ring_info), heap_peak(m_index_buffer_ring_info), heap_peak(m_texture_upload_buffer_ring_info), heap_peak(m_transform_constants_ring_info), heap_peak(m_fragment_constants_ring_info),
+				m_attrib_ring_info.is_device_local() ? " (VRAM)" : ""));
 		}
 
 		direct_fbo->release();
@@ -778,7 +854,9 @@ void VKGSRender::flip(const rsx::display_flip_info_t& info)
 		vk::change_image_layout(*m_current_command_buffer, target_image, target_layout, present_layout, subresource_range);
 	}
 
+	end_frame_timing();
 	queue_swap_request();
+	begin_frame_timing();
 
 	m_frame_stats.flip_time = m_profiler.duration();
 
@@ -64,6 +64,13 @@ namespace vk
 
 			return callback(result);
 		}
+
+		static
+			void touch_pending_pipeline(const vertex_program_type& vertexProgramData, const fragment_program_type& fragmentProgramData, const vk::pipeline_props& pipelineProperties)
+		{
+			VkShaderModule modules[2] = { vertexProgramData.handle, fragmentProgramData.handle };
+			vk::pipe_compiler::touch(vk::pipe_compiler::get_job_key(pipelineProperties, modules));
+		}
 	};
 
 	struct program_cache : public program_state_cache<VKTraits>
@@ -1,6 +1,7 @@
 #include "stdafx.h"
 #include "VKProgramPipeline.h"
 #include "vkutils/device.h"
+#include "util/serialization.hpp"
 #include <string>
 
 namespace vk
@@ -9,6 +10,27 @@ namespace vk
 	{
 		using namespace ::glsl;
 
+		void serialize_program_inputs(utils::serial& ar, const std::vector<program_input>& inputs)
+		{
+			ar(::size32(inputs));
+
+			for (const auto& in : inputs)
+			{
+				ar(in.domain, in.type, in.location, in.name);
+			}
+		}
+
+		void deserialize_program_inputs(utils::serial& ar, std::vector<program_input>& inputs)
+		{
+			const u32 count = ar;
+			inputs.resize(count);
+
+			for (auto& in : inputs)
+			{
+				ar(in.domain, in.type, in.location, in.name);
+			}
+		}
+
 		void shader::create(::glsl::program_domain domain, const std::string& source)
 		{
 			type     = domain;
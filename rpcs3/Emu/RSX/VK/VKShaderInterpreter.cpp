@@ -165,14 +165,48 @@ namespace vk
 			builder << "#define WITH_STIPPLING\n";
 		}
 
+		if (compiler_options & program_common::interpreter::COMPILER_OPT_ENABLE_TWO_SIDED_LIGHTING)
+		{
+			builder << "#define WITH_TWO_SIDED_LIGHTING\n";
+		}
+
 		const char* type_names[] = { "sampler1D", "sampler2D", "sampler3D", "samplerCube" };
 		if (compiler_options & program_common::interpreter::COMPILER_OPT_ENABLE_TEXTURES)
 		{
-			builder << "#define WITH_TEXTURES\n\n";
+			builder << "#define WITH_TEXTURES\n";
+
+			const u64 texture_types = compiler_options & program_common::interpreter::COMPILER_OPT_TEXTURE_TYPE_MASK;
+			if ((texture_types & (texture_types - 1)) == 0)
+			{
+				builder << "#define WITH_SINGLE_TEXTURE_TYPE\n";
+			}
+
+			// Bindings follow the descriptor layout order, which differs from the option bit order
+			const u64 type_options[] =
+			{
+				program_common::interpreter::COMPILER_OPT_ENABLE_TEXTURE_1D,
+				program_common::interpreter::COMPILER_OPT_ENABLE_TEXTURE_2D,
+				program_common::interpreter::COMPILER_OPT_ENABLE_TEXTURE_3D,
+				program_common::interpreter::COMPILER_OPT_ENABLE_TEXTURE_CUBE
+			};
+
+			const char* type_defines[] = { "WITH_TEXTURE_1D", "WITH_TEXTURE_2D", "WITH_TEXTURE_3D", "WITH_TEXTURE_CUBE" };
+			for (int i = 0; i < 4; ++i)
+			{
+				if (compiler_options & type_options[i])
+				{
+					builder << "#define " << type_defines[i] << "\n";
+				}
+			}
+
+			builder << "\n";
 
-			for (int i = 0, bind_location = m_fragment_textures_start; i < 4; ++i)
+			for (int i = 0, bind_location = m_fragment_textures_start; i < 4; ++i, ++bind_location)
 			{
-				builder << "layout(set=0, binding=" << bind_location++ << ") " << "uniform " << type_names[i] << " " << type_names[i] << "_array[16];\n";
+				if (compiler_options & type_options[i])
+				{
+					builder << "layout(set=0, binding=" << bind_location << ") " << "uniform " << type_names[i] << " " << type_names[i] << "_array[16];\n";
+				}
 			}
 
 			builder << "\n"
@@ -200,6 +234,14 @@ namespace vk
 		fs->create(::glsl::program_domain::glsl_fragment_program, s);
 		fs->compile();
 
+		m_fs_cache[compiler_options].reset(fs);
+
+		if (!m_fs_inputs.empty())
+		{
+			// Input table is shared by all variants
+			return fs;
+		}
+
 		// Prepare input table
 		vk::glsl::program_input in;
 		in.location = binding_table.fragment_constant_buffers_bind_slot;
@@ -223,7 +265,6 @@ namespace vk
 			m_fs_inputs.push_back(in);
 		}
 
-		m_fs_cache[compiler_options].reset(fs);
 		return fs;
 	}
 
@@ -395,7 +436,10 @@ namespace vk
 		create_descriptor_pools(dev);
 
 		build_vs();
-		// TODO: Seed the cache
+
+		// Seed the fragment stage with the variants most titles start with, pipelines still depend on the draw state
+		build_fs(program_common::interpreter::COMPILER_OPT_ENABLE_TEXTURES | program_common::interpreter::COMPILER_OPT_ENABLE_TEXTURE_2D);
+		build_fs(program_common::interpreter::COMPILER_OPT_ENABLE_TEXTURES | program_common::interpreter::COMPILER_OPT_ENABLE_TEXTURE_2D | program_common::interpreter::COMPILER_OPT_ENABLE_F32_EXPORT);
 	}
 
 	void shader_interpreter::destroy()
@@ -552,7 +596,7 @@ namespace vk
 		return new_descriptor_set;
 	}
 
-	glsl::program* shader_interpreter::get(const vk::pipeline_props& properties, const program_hash_util::fragment_program_utils::fragment_program_metadata& metadata)
+	glsl::program* shader_interpreter::get(const vk::pipeline_props& properties, const program_hash_util::fragment_program_utils::fragment_program_metadata& metadata, u32 fp_texture_dimensions)
 	{
 		pipeline_key key;
 		key.compiler_opt = 0;
@@ -594,6 +638,8 @@ namespace vk
 		if (metadata.has_branch_instructions) key.compiler_opt |= program_common::interpreter::COMPILER_OPT_ENABLE_FLOW_CTRL;
 		if (metadata.has_pack_instructions) key.compiler_opt |= program_common::interpreter::COMPILER_OPT_ENABLE_PACKING;
 		if (rsx::method_registers.polygon_stipple_enabled()) key.compiler_opt |= program_common::interpreter::COMPILER_OPT_ENABLE_STIPPLING;
+		if (rsx::method_registers.two_side_light_en()) key.compiler_opt |= program_common::interpreter::COMPILER_OPT_ENABLE_TWO_SIDED_LIGHTING;
+		key.compiler_opt |= program_common::interpreter::get_texture_type_options(metadata.referenced_textures_mask, fp_texture_dimensions);
 
 		if (m_current_key == key) [[likely]]
 		{
@@ -337,6 +337,12 @@ namespace vk
 			return synchronized;
 		}
 
+		// True once the GPU has finished writing the readback data, the flush then only needs host memory access
+		bool is_readback_complete() const
+		{
+			return dma_fence && dma_fence->status() == VK_EVENT_SET;
+		}
+
 		bool has_compatible_format(vk::image* tex) const
 		{
 			return vram_texture->info.format == tex->info.format;
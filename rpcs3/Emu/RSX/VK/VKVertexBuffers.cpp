@@ -247,7 +247,6 @@ vk::vertex_upload_info VKGSRender::upload_vertex_data()
 	{
 		//Check if cacheable
 		//Only data in the 'persistent' block may be cached
-		//TODO: make vertex cache keep local data beyond frame boundaries and hook notify command
 		bool in_cache = false;
 		bool to_store = false;
 		u32  storage_address = -1;
@@ -258,6 +257,8 @@ vk::vertex_upload_info VKGSRender::upload_vertex_data()
 			const auto data_offset = (vertex_base * m_vertex_layout.interleaved_blocks[0].attribute_stride);
 			storage_address = m_vertex_layout.interleaved_blocks[0].real_offset_address + data_offset;
 
+			m_vertex_cache->update_heap_state(m_attrib_ring_info.get_allocation_marker(), m_attrib_ring_info.size());
+
 			if (auto cached = m_vertex_cache->find_vertex_range(storage_address, VK_FORMAT_R8_UINT, required.first))
 			{
 				ensure(cached->local_address == storage_address);
@@ -5,6 +5,9 @@
 #include "VKHelpers.h"
 #include "vkutils/device.h"
 #include "../Program/GLSLCommon.h"
+#include "../Program/ProgramStateCache.h"
+
+#include "util/serialization.hpp"
 
 
 std::string VKVertexDecompilerThread::getFloatTypeName(usz elementCount)
@@ -328,8 +331,30 @@ VKVertexProgram::~VKVertexProgram()
 void VKVertexProgram::Decompile(const RSXVertexProgram& prog)
 {
 	std::string source;
-	VKVertexDecompilerThread decompiler(prog, source, parr, *this);
-	decompiler.Task();
+
+	auto& cache = rsx::decompiled_program_cache::get();
+	const u64 variant = rpcs3::hash64(rpcs3::hash_struct(vk::g_render_device->get_pipeline_binding_table()), (u64{0x564b5650} << 32) | // 'VKVP'
+		(u64{vk::emulate_conditional_rendering()} << 0) |
+		(u64{vk::g_render_device->get_shader_types_support().allow_float64} << 1));
+	const u64 key = cache.get_key(prog, variant);
+
+	if (const auto cached = cache.find(key))
+	{
+		source = cached->source;
+
+		utils::serial ar;
+		ar.set_reading_state(std::vector<u8>(cached->metadata));
+		vk::glsl::deserialize_program_inputs(ar, uniforms);
+	}
+	else
+	{
+		VKVertexDecompilerThread decompiler(prog, source, parr, *this);
+		decompiler.Task();
+
+		utils::serial ar;
+		vk::glsl::serialize_program_inputs(ar, uniforms);
+		cache.insert(key, source, std::move(ar.data));
+	}
 
 	shader.create(::glsl::program_domain::glsl_vertex_program, source);
 }
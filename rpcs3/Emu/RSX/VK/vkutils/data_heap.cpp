@@ -6,6 +6,7 @@
 #include "../VKHelpers.h"
 #include "../VKResourceManager.h"
 #include "Emu/IdManager.h"
+#include "Emu/system_config.h"
 
 #include <memory>
 
@@ -13,14 +14,17 @@ namespace vk
 {
 	data_heap g_upload_heap;
 
+	// Legacy BAR apertures are 256M and shared with the driver; only a resized BAR has room for streaming heaps
+	static constexpr u64 s_min_rebar_size = 0x40000000ull;
+
 	void data_heap::create(VkBufferUsageFlags usage, usz size, const char* name, usz guard, VkBool32 notify)
 	{
 		::data_heap::init(size, name, guard);
 
 		const auto& memory_map = g_render_device->get_memory_mapping();
 
-		VkFlags memory_flags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
-		auto memory_index = memory_map.host_visible_coherent;
+		memory_flags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+		memory_index = memory_map.host_visible_coherent;
 
 		if (!(get_heap_compatible_buffer_types() & usage))
 		{
@@ -31,6 +35,17 @@ namespace vk
 			memory_flags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
 			memory_index = memory_map.device_local;
 		}
+		else if (!(usage & VK_BUFFER_USAGE_TRANSFER_SRC_BIT) &&
+			memory_map.device_bar != VK_MAX_MEMORY_TYPES &&
+			memory_map.device_bar_total_bytes >= s_min_rebar_size &&
+			g_cfg.video.vk.use_rebar_heaps)
+		{
+			// Data consumed directly by shaders is written straight into VRAM so the GPU does not fetch it over the bus on every draw.
+			// Staging-only heaps (transfer source) are read once by a copy and stay in system memory.
+			memory_flags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+			memory_index = memory_map.device_bar;
+			rsx_log.notice("[%s] Using host-visible device memory", name);
+		}
 
 		heap = std::make_unique<buffer>(*g_render_device, size, memory_index, memory_flags, usage, 0);
 
@@ -45,6 +60,11 @@ namespace vk
 			unmap(true);
 		}
 
+		if (heap)
+		{
+			rsx_log.notice("[%s] Peak occupancy was %llu KiB of %llu KiB", m_name, get_peak_usage() / 1024, m_size / 1024);
+		}
+
 		heap.reset();
 		shadow.reset();
 	}
@@ -77,10 +97,6 @@ namespace vk
 		}
 
 		VkBufferUsageFlags usage = heap->info.usage;
-		const auto& memory_map = g_render_device->get_memory_mapping();
-
-		VkFlags memory_flags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
-		auto memory_index = memory_map.host_visible_coherent;
 
 		// Update heap information and reset the allocator
 		::data_heap::init(aligned_new_size, m_name, m_min_guard_size);
@@ -152,6 +168,11 @@ namespace vk
 		return !dirty_ranges.empty();
 	}
 
+	bool data_heap::is_device_local() const
+	{
+		return !shadow && (memory_flags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+	}
+
 	bool data_heap::is_critical() const
 	{
 		if (!::data_heap::is_critical())
@@ -17,6 +17,9 @@ namespace vk
 		bool mapped = false;
 		void* _ptr = nullptr;
 
+		u32 memory_index = 0;
+		VkFlags memory_flags = 0;
+
 		bool notify_on_grow = false;
 
 		std::unique_ptr<buffer> shadow;
@@ -43,6 +46,7 @@ namespace vk
 		// Properties
 		bool is_dirty() const;
 		bool is_critical() const override;
+		bool is_device_local() const;
 	};
 
 	extern data_heap* get_upload_heap();
@@ -647,6 +647,8 @@ namespace vk
 		memory_type_mapping result;
 		result.device_local = VK_MAX_MEMORY_TYPES;
 		result.host_visible_coherent = VK_MAX_MEMORY_TYPES;
+		result.device_bar = VK_MAX_MEMORY_TYPES;
+		result.device_bar_total_bytes = 0;
 
 		bool host_visible_cached = false;
 		VkDeviceSize host_visible_vram_size = 0;
@@ -678,9 +680,20 @@ namespace vk
 					host_visible_vram_size = heap.size;
 					host_visible_cached = is_cached;
 				}
+
+				if (is_device_local && !is_cached && result.device_bar_total_bytes < heap.size)
+				{
+					result.device_bar = i;
+					result.device_bar_total_bytes = heap.size;
+				}
 			}
 		}
 
+		if (result.device_bar != VK_MAX_MEMORY_TYPES)
+		{
+			rsx_log.notice("Vulkan: Host-visible device memory found, %llu MiB", result.device_bar_total_bytes / 0x100000);
+		}
+
 		if (result.device_local == VK_MAX_MEMORY_TYPES)
 			fmt::throw_exception("GPU doesn't support device local memory");
 		if (result.host_visible_coherent == VK_MAX_MEMORY_TYPES)
@@ -30,6 +30,8 @@ namespace vk
 	{
 		u32 host_visible_coherent;
 		u32 device_local;
+		u32 device_bar;             // Device-local memory the host can map directly, VK_MAX_MEMORY_TYPES if none
+		u64 device_bar_total_bytes; // Size of the heap backing device_bar. Larger than the legacy 256M window when resizable BAR is active
 
 		PFN_vkGetMemoryHostPointerPropertiesEXT _vkGetMemoryHostPointerPropertiesEXT;
 	};
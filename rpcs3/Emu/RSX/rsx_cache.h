@@ -1,6 +1,7 @@
 #pragma once
 #include "Utilities/File.h"
 #include "Utilities/lockless.h"
+#include "Utilities/mutex.h"
 #include "Utilities/Thread.h"
 #include "Program/ProgramStateCache.h"
 #include "Emu/System.h"
@@ -10,8 +11,11 @@
 
 #include "rsx_utils.h"
 #include <chrono>
+#include <span>
 #include <unordered_map>
+#include <unordered_set>
 
+#include "util/asm.hpp"
 #include "util/sysinfo.hpp"
 #include "util/fnv_hash.hpp"
 
@@ -51,10 +55,64 @@ namespace rsx
 			pipeline_storage_type pipeline_properties;
 		};
 
+		/**
+		 * Pipeline archive layout:
+		 *   archive_header
+		 *   { record_header, payload, padding to 8 bytes } ...
+		 * Records are only ever appended. Programs are stored once per ucode hash and shared by all pipelines using them.
+		 */
+		static constexpr char archive_magic[8] = { 'R', 'P', 'C', 'S', '3', 'S', 'C', 'A' };
+		static constexpr u32 archive_version = 2;
+
+		struct archive_header
+		{
+			char magic[8];
+			u32 version;
+			u32 pipeline_data_size;   // Guards against pipeline_storage_type layout changes
+		};
+
+		enum class record_type : u32
+		{
+			vertex_program = 1,
+			fragment_program = 2,
+			pipeline = 3,
+		};
+
+		struct record_header
+		{
+			record_type type;
+			u32 size;                 // Payload length in bytes, excluding padding
+			u64 key;                  // Program ucode hash or pipeline key
+			u64 checksum;             // Covers the fields above and the padded payload
+		};
+
+		struct archive_index
+		{
+			std::vector<u8> data;
+			std::unordered_map<u64, std::span<const u8>> vertex_programs;
+			std::unordered_map<u64, std::span<const u8>> fragment_programs;
+			std::vector<usz> pipelines;  // Offsets of pipeline_data payloads in data
+			usz valid_length = 0;        // Length of the well-formed prefix of the archive
+			usz wasted_length = 0;       // Bytes taken by records that will never be loaded
+		};
+
 		std::string version_prefix;
 		std::string root_path;
 		std::string pipeline_class_name;
-		lf_fifo<std::unique_ptr<u8[]>, 100> fragment_program_data;
+		std::string archive_path;
+
+		shared_mutex m_archive_mutex;
+		fs::file m_archive;
+		std::unique_ptr<named_thread<std::function<void()>>> m_compactor;
+
+		// Records are serialized by store() and written out in batches by the writer thread.
+		// m_records_mutex guards the sets of objects already present in the archive.
+		shared_mutex m_records_mutex;
+		std::unordered_set<u64> m_stored_vertex_programs;
+		std::unordered_set<u64> m_stored_fragment_programs;
+		std::unordered_set<u64> m_stored_pipelines;
+		lf_queue<std::vector<u8>> m_pending_records;
+		std::unique_ptr<named_thread<std::function<void()>>> m_writer;
 
 		backend_storage& m_storage;
 
@@ -63,39 +121,367 @@ namespace rsx
 			return fmt::format("%s pipeline object %u of %u", index == 0 ? "Loading" : "Compiling", processed, entry_count);
 		}
 
-		void load_shaders(uint nb_workers, unpacked_type& unpacked, std::string& directory_path, std::vector<fs::dir_entry>& entries, u32 entry_count,
-		    shader_loading_dialog* dlg)
+		static u64 get_pipeline_key(const pipeline_data& data)
 		{
-			atomic_t<u32> processed(0);
+			u64 state_hash = 0;
+			state_hash ^= rpcs3::hash_base<u32>(data.vp_ctrl);
+			state_hash ^= rpcs3::hash_base<u32>(data.fp_ctrl);
+			state_hash ^= rpcs3::hash_base<u32>(data.vp_texture_dimensions);
+			state_hash ^= rpcs3::hash_base<u32>(data.fp_texture_dimensions);
+			state_hash ^= rpcs3::hash_base<u32>(data.fp_texcoord_control);
+			state_hash ^= rpcs3::hash_base<u16>(data.fp_unnormalized_coords);
+			state_hash ^= rpcs3::hash_base<u16>(data.fp_height);
+			state_hash ^= rpcs3::hash_base<u16>(data.fp_pixel_layout);
+			state_hash ^= rpcs3::hash_base<u16>(data.fp_lighting_flags);
+			state_hash ^= rpcs3::hash_base<u16>(data.fp_shadow_textures);
+			state_hash ^= rpcs3::hash_base<u16>(data.fp_redirected_textures);
 
-			std::function<void(u32)> shader_load_worker = [&](u32 stop_at)
+			u64 key = rpcs3::fnv_seed;
+			key = rpcs3::hash64(key, data.vertex_program_hash);
+			key = rpcs3::hash64(key, data.fragment_program_hash);
+			key = rpcs3::hash64(key, data.pipeline_storage_hash);
+			key = rpcs3::hash64(key, state_hash);
+			return key;
+		}
+
+		// FNV-1a over the record header and its padded payload, both being multiples of 8 bytes
+		static u64 get_record_checksum(const record_header& header, const u8* payload)
+		{
+			u64 checksum = rpcs3::fnv_seed;
+			checksum = rpcs3::hash64(checksum, static_cast<u64>(header.type) | (u64{header.size} << 32));
+			checksum = rpcs3::hash64(checksum, header.key);
+
+			for (usz offset = 0, length = utils::align<usz>(header.size, 8); offset < length; offset += 8)
 			{
-				u32 pos;
-				// Processed is incremented before work starts in order to avoid two workers working on the same shader
-				while (((pos = processed++) < stop_at) && !Emu.IsStopped())
+				u64 word;
+				std::memcpy(&word, payload + offset, 8);
+				checksum = rpcs3::hash64(checksum, word);
+			}
+
+			return checksum;
+		}
+
+		static std::vector<u8> make_record(record_type type, u64 key, const void* payload, u32 size)
+		{
+			record_header header{ type, size, key, 0 };
+
+			std::vector<u8> result(sizeof(record_header) + utils::align<usz>(size, 8));
+			std::memcpy(result.data() + sizeof(header), payload, size);
+
+			header.checksum = get_record_checksum(header, result.data() + sizeof(header));
+			std::memcpy(result.data(), &header, sizeof(header));
+			return result;
+		}
+
+		static void append_record(std::vector<u8>& out, record_type type, u64 key, const void* payload, u32 size)
+		{
+			const auto record = make_record(type, key, payload, size);
+			out.insert(out.end(), record.begin(), record.end());
+		}
+
+		// Parse the archive into an in-memory index. The whole file is fetched with a single read.
+		archive_index read_archive() const
+		{
+			archive_index result;
+
+			if (fs::file f(archive_path); f)
+			{
+				result.data = f.to_vector<u8>();
+			}
+
+			const auto& data = result.data;
+			if (data.size() < sizeof(archive_header))
+			{
+				return result;
+			}
+
+			archive_header header;
+			std::memcpy(&header, data.data(), sizeof(header));
+
+			if (std::memcmp(header.magic, archive_magic, sizeof(archive_magic)) != 0 ||
+				header.version != archive_version ||
+				header.pipeline_data_size != sizeof(pipeline_data))
+			{
+				rsx_log.error("Discarding pipeline archive %s since it's not binary compatible with the current shader cache", archive_path);
+				result.data.clear();
+				return result;
+			}
+
+			std::unordered_set<u64> pipeline_keys;
+			usz offset = sizeof(archive_header);
+
+			while (offset + sizeof(record_header) <= data.size())
+			{
+				record_header record;
+				std::memcpy(&record, data.data() + offset, sizeof(record));
+
+				const usz payload_offset = offset + sizeof(record_header);
+				const usz record_end = payload_offset + utils::align<usz>(record.size, 8);
+
+				if (record_end > data.size() || record.checksum != get_record_checksum(record, data.data() + payload_offset))
 				{
-					fs::dir_entry tmp = entries[pos];
+					// Truncated or torn tail, e.g from an interrupted write
+					break;
+				}
 
-					const auto filename = directory_path + "/" + tmp.name;
-					fs::file f(filename);
+				const std::span<const u8> payload{ data.data() + payload_offset, record.size };
+				bool wasted = false;
 
-					if (!f)
+				switch (record.type)
+				{
+				case record_type::vertex_program:
+					wasted = !result.vertex_programs.emplace(record.key, payload).second;
+					break;
+				case record_type::fragment_program:
+					wasted = !result.fragment_programs.emplace(record.key, payload).second;
+					break;
+				case record_type::pipeline:
+					if (record.size == sizeof(pipeline_data) && pipeline_keys.insert(record.key).second)
 					{
-						// Unexpected error, but avoid crash
-						continue;
+						result.pipelines.push_back(payload_offset);
 					}
+					else
+					{
+						wasted = true;
+					}
+					break;
+				default:
+					wasted = true;
+					break;
+				}
+
+				if (wasted)
+				{
+					result.wasted_length += record_end - offset;
+				}
+
+				offset = record_end;
+			}
+
+			result.valid_length = offset;
+			return result;
+		}
+
+		// Opens the archive for appending, creating it or dropping a damaged tail as needed. Requires m_archive_mutex.
+		bool open_archive(usz valid_length)
+		{
+			if (!m_archive.open(archive_path, fs::read + fs::write + fs::create))
+			{
+				rsx_log.error("Failed to open pipeline archive %s (%s)", archive_path, fs::g_tls_error);
+				return false;
+			}
+
+			if (valid_length < sizeof(archive_header))
+			{
+				archive_header header{};
+				std::memcpy(header.magic, archive_magic, sizeof(archive_magic));
+				header.version = archive_version;
+				header.pipeline_data_size = sizeof(pipeline_data);
+
+				m_archive.trunc(0);
+				m_archive.write(header);
+			}
+			else if (m_archive.size() != valid_length)
+			{
+				rsx_log.warning("Pipeline archive %s has a damaged tail, %llu bytes dropped", archive_path, m_archive.size() - valid_length);
+				m_archive.trunc(valid_length);
+			}
+
+			m_archive.seek(0, fs::seek_end);
+			return true;
+		}
+
+		// Requires m_archive_mutex
+		void write_record(record_type type, u64 key, const void* payload, u32 size)
+		{
+			const auto record = make_record(type, key, payload, size);
+			m_archive.write(record.data(), record.size());
+		}
+
+		void writer_loop()
+		{
+			while (true)
+			{
+				std::vector<u8> batch;
+
+				for (auto&& records : m_pending_records.pop_all())
+				{
+					batch.insert(batch.end(), records.begin(), records.end());
+				}
 
-					if (f.size() != sizeof(pipeline_data))
+				if (batch.empty())
+				{
+					// Drain everything queued before exiting
+					if (thread_ctrl::state() == thread_state::aborting)
 					{
-						rsx_log.error("Removing cached pipeline object %s since it's not binary compatible with the current shader cache", tmp.name.c_str());
-						fs::remove_file(filename);
-						continue;
+						break;
 					}
 
+					thread_ctrl::wait_on(m_pending_records, nullptr);
+					continue;
+				}
+
+				std::lock_guard lock(m_archive_mutex);
+
+				if (m_archive && m_archive.write(batch.data(), batch.size()) != batch.size())
+				{
+					rsx_log.error("Failed to write %llu bytes to pipeline archive %s (%s)", batch.size(), archive_path, fs::g_tls_error);
+				}
+			}
+		}
+
+		// Move pipelines stored with the old one-file-per-object layout into the archive. Requires m_archive_mutex and m_records_mutex.
+		void import_legacy_cache(const std::string& directory_path)
+		{
+			fs::dir root(directory_path);
+			if (!root)
+			{
+				return;
+			}
+
+			u32 imported = 0;
+			std::vector<std::string> imported_files;
+
+			for (auto&& tmp : root)
+			{
+				if (tmp.is_directory)
+					continue;
+
+				const auto filename = directory_path + "/" + tmp.name;
+
+				if (fs::file f(filename); f && f.size() == sizeof(pipeline_data))
+				{
 					pipeline_data pdata{};
-					f.read(&pdata, f.size());
+					f.read(&pdata, sizeof(pdata));
+
+					const auto vp_data = fs::file(fmt::format("%s/raw/%llX.vp", root_path, pdata.vertex_program_hash)).to_vector<u8>();
+					const auto fp_data = fs::file(fmt::format("%s/raw/%llX.fp", root_path, pdata.fragment_program_hash)).to_vector<u8>();
+
+					if (!vp_data.empty() && !fp_data.empty())
+					{
+						if (m_stored_vertex_programs.insert(pdata.vertex_program_hash).second)
+						{
+							write_record(record_type::vertex_program, pdata.vertex_program_hash, vp_data.data(), ::size32(vp_data));
+						}
+
+						if (m_stored_fragment_programs.insert(pdata.fragment_program_hash).second)
+						{
+							write_record(record_type::fragment_program, pdata.fragment_program_hash, fp_data.data(), ::size32(fp_data));
+						}
+
+						if (const u64 key = get_pipeline_key(pdata); m_stored_pipelines.insert(key).second)
+						{
+							write_record(record_type::pipeline, key, &pdata, sizeof(pdata));
+							imported++;
+						}
+
+						// Only files whose contents made it into the archive are removed, the rest stay for a later attempt
+						imported_files.push_back(filename);
+					}
+				}
+			}
+
+			root.close();
+
+			for (const auto& file : imported_files)
+			{
+				fs::remove_file(file);
+			}
+
+			// Fails harmlessly while unmigrated files remain
+			fs::remove_dir(directory_path);
+
+			if (imported)
+			{
+				rsx_log.notice("Imported %u pipeline objects into %s", imported, archive_path);
+			}
+		}
+
+		// Rewrite the archive without dead records. Anything appended while the copy is being built is carried over.
+		void compact_archive(archive_index index)
+		{
+			fs::pending_file temp(archive_path);
+			if (!temp.file)
+			{
+				return;
+			}
+
+			temp.file.write(index.data.data(), sizeof(archive_header));
+
+			std::unordered_set<u64> live_vertex_programs, live_fragment_programs;
+			for (const usz offset : index.pipelines)
+			{
+				pipeline_data pdata;
+				std::memcpy(&pdata, index.data.data() + offset, sizeof(pdata));
+
+				const auto vp = index.vertex_programs.find(pdata.vertex_program_hash);
+				const auto fp = index.fragment_programs.find(pdata.fragment_program_hash);
+
+				if (vp == index.vertex_programs.end() || fp == index.fragment_programs.end())
+				{
+					continue;
+				}
+
+				if (live_vertex_programs.insert(vp->first).second)
+				{
+					const auto record = make_record(record_type::vertex_program, vp->first, vp->second.data(), ::size32(vp->second));
+					temp.file.write(record.data(), record.size());
+				}
+
+				if (live_fragment_programs.insert(fp->first).second)
+				{
+					const auto record = make_record(record_type::fragment_program, fp->first, fp->second.data(), ::size32(fp->second));
+					temp.file.write(record.data(), record.size());
+				}
+
+				const auto record = make_record(record_type::pipeline, get_pipeline_key(pdata), &pdata, sizeof(pdata));
+				temp.file.write(record.data(), record.size());
+			}
+
+			std::lock_guard lock(m_archive_mutex);
+
+			if (m_archive && m_archive.size() > index.valid_length)
+			{
+				std::vector<u8> tail(m_archive.size() - index.valid_length);
+				m_archive.seek(index.valid_length);
+				m_archive.read(tail.data(), tail.size());
+				temp.file.write(tail.data(), tail.size());
+			}
+
+			const u64 old_size = m_archive ? m_archive.size() : 0;
+			const u64 new_size = temp.file.size();
+
+			m_archive.close();
+
+			if (!temp.commit())
+			{
+				rsx_log.error("Failed to compact pipeline archive %s (%s)", archive_path, fs::g_tls_error);
+			}
+			else
+			{
+				rsx_log.notice("Compacted pipeline archive %s (%llu -> %llu bytes)", archive_path, old_size, new_size);
+			}
+
+			if (m_archive.open(archive_path, fs::read + fs::write))
+			{
+				m_archive.seek(0, fs::seek_end);
+			}
+		}
 
-					auto entry = unpack(pdata);
+		void load_shaders(uint nb_workers, unpacked_type& unpacked, const archive_index& index, u32 entry_count, shader_loading_dialog* dlg)
+		{
+			atomic_t<u32> processed(0);
+
+			std::function<void(u32)> shader_load_worker = [&](u32 stop_at)
+			{
+				u32 pos;
+				// Processed is incremented before work starts in order to avoid two workers working on the same shader
+				while (((pos = processed++) < stop_at) && !Emu.IsStopped())
+				{
+					pipeline_data pdata;
+					std::memcpy(&pdata, index.data.data() + index.pipelines[pos], sizeof(pdata));
+
+					auto entry = unpack(pdata, index);
 
 					if (std::get<1>(entry).data.empty() || !std::get<2>(entry).ucode_length)
 					{
@@ -160,9 +546,27 @@ namespace rsx
 			}
 			else
 			{
+				atomic_t<u32> workers_without_context = 0;
+
 				named_thread_group workers("RSX Worker ", nb_workers, [&]()
 				{
-					worker(entry_count);
+					if constexpr (requires { m_storage.acquire_worker_context(); })
+					{
+						// Without a context this thread cannot do any work, the other workers drain the queue
+						if (auto context = m_storage.acquire_worker_context())
+						{
+							worker(entry_count);
+							m_storage.release_worker_context(context);
+						}
+						else
+						{
+							workers_without_context++;
+						}
+					}
+					else
+					{
+						worker(entry_count);
+					}
 				});
 
 				u32 current_progress = 0;
@@ -173,6 +577,14 @@ namespace rsx
 
 					if (Emu.IsStopped()) break;
 
+					if (workers_without_context == nb_workers)
+					{
+						// No worker could acquire a context, drain the queue on the calling thread
+						rsx_log.warning("No shader cache worker could acquire a context, processing %u entries on the calling thread", entry_count);
+						workers_without_context = 0;
+						worker(entry_count);
+					}
+
 					current_progress = std::min(processed.load(), entry_count);
 
 					if (last_update_progress != current_progress)
@@ -202,10 +614,29 @@ namespace rsx
 				if (std::string cache_path = rpcs3::cache::get_ppu_cache(); !cache_path.empty())
 				{
 					root_path = std::move(cache_path) + "shaders_cache/";
+					archive_path = root_path + "pipelines/" + pipeline_class_name + "/" + version_prefix + ".pack";
 				}
 			}
 		}
 
+		~shaders_cache()
+		{
+			// Flush pending stores, then let a running compaction finish
+			m_writer.reset();
+			m_compactor.reset();
+
+			if (!root_path.empty())
+			{
+				rsx::decompiled_program_cache::get().save();
+			}
+		}
+
+		// Directory holding the caches of this pipeline class, empty when the on-disk cache is disabled
+		std::string get_cache_directory() const
+		{
+			return root_path.empty() ? std::string{} : root_path + "pipelines/" + pipeline_class_name + "/";
+		}
+
 		template <typename... Args>
 		void load(shader_loading_dialog* dlg, Args&& ...args)
 		{
@@ -214,34 +645,60 @@ namespace rsx
 				return;
 			}
 
-			std::string directory_path = root_path + "/pipelines/" + pipeline_class_name + "/" + version_prefix;
+			fs::create_path(root_path + "/pipelines/" + pipeline_class_name);
 
-			fs::dir root = fs::dir(directory_path);
+			// Decompiled sources are persisted next to the archive so that preloading skips the decompilers
+			auto& decompiled_cache = rsx::decompiled_program_cache::get();
+			decompiled_cache.load(root_path + "pipelines/" + pipeline_class_name + "/" + version_prefix + ".decompiled");
 
-			if (!root)
+			archive_index index;
 			{
-				fs::create_path(directory_path);
-				fs::create_path(root_path + "/raw");
-				return;
-			}
+				std::scoped_lock lock(m_archive_mutex, m_records_mutex);
 
-			std::vector<fs::dir_entry> entries;
+				index = read_archive();
 
-			for (auto&& tmp : root)
-			{
-				if (tmp.is_directory)
-					continue;
+				for (const auto& [key, payload] : index.vertex_programs)
+				{
+					m_stored_vertex_programs.insert(key);
+				}
+
+				for (const auto& [key, payload] : index.fragment_programs)
+				{
+					m_stored_fragment_programs.insert(key);
+				}
 
-				entries.push_back(tmp);
+				for (const usz offset : index.pipelines)
+				{
+					pipeline_data pdata;
+					std::memcpy(&pdata, index.data.data() + offset, sizeof(pdata));
+					m_stored_pipelines.insert(get_pipeline_key(pdata));
+				}
+
+				if (!open_archive(index.valid_length))
+				{
+					return;
+				}
+
+				m_writer = std::make_unique<named_thread<std::function<void()>>>("RSX Shader Cache Writer", [this]()
+				{
+					writer_loop();
+				});
+
+				const usz stored_count = m_stored_pipelines.size();
+				import_legacy_cache(root_path + "/pipelines/" + pipeline_class_name + "/" + version_prefix);
+
+				if (m_stored_pipelines.size() != stored_count)
+				{
+					// Reparse to pick up the imported records
+					index = read_archive();
+				}
 			}
 
-			u32 entry_count = ::size32(entries);
+			u32 entry_count = ::size32(index.pipelines);
 
 			if (!entry_count)
 				return;
 
-			root.rewind();
-
 			// Progress dialog
 			std::unique_ptr<shader_loading_dialog> fallback_dlg;
 			if (!dlg)
@@ -258,9 +715,15 @@ namespace rsx
 
 			// Preload everything needed to compile the shaders
 			unpacked_type unpacked;
-			uint nb_workers = g_cfg.video.renderer == video_renderer::vulkan ? utils::get_thread_count() : 1;
+			uint nb_workers = utils::get_thread_count();
 
-			load_shaders(nb_workers, unpacked, directory_path, entries, entry_count, dlg);
+			if constexpr (requires { m_storage.get_preload_worker_count(); })
+			{
+				// Backends with per-thread API state (OpenGL contexts) can only feed as many workers as they have contexts
+				nb_workers = m_storage.get_preload_worker_count();
+			}
+
+			load_shaders(nb_workers, unpacked, index, entry_count, dlg);
 
 			// Account for any invalid entries
 			entry_count = unpacked.size();
@@ -269,6 +732,16 @@ namespace rsx
 
 			dlg->refresh();
 			dlg->close();
+
+			decompiled_cache.save();
+
+			if (index.wasted_length > index.data.size() / 4 && !Emu.IsStopped())
+			{
+				m_compactor = std::make_unique<named_thread<std::function<void()>>>("RSX Shader Cache Compactor", [this, index = std::move(index)]() mutable
+				{
+					compact_archive(std::move(index));
+				});
+			}
 		}
 
 		void store(const pipeline_storage_type &pipeline, const RSXVertexProgram &vp, const RSXFragmentProgram &fp)
@@ -284,80 +757,63 @@ namespace rsx
 				return;
 			}
 
-			pipeline_data data = pack(pipeline, vp, fp);
-
-			std::string fp_name = root_path + "/raw/" + fmt::format("%llX.fp", data.fragment_program_hash);
-			std::string vp_name = root_path + "/raw/" + fmt::format("%llX.vp", data.vertex_program_hash);
-
-			// Writeback to cache either if file does not exist or it is invalid (unexpected size)
-			// Note: fs::write_file is not atomic, if the process is terminated in the middle an empty file is created
-			if (fs::stat_t s{}; !fs::stat(fp_name, s) || s.size != fp.ucode_length)
+			if (!m_writer)
 			{
-				fs::write_file(fp_name, fs::rewrite, fp.get_data(), fp.ucode_length);
+				return;
 			}
 
-			if (fs::stat_t s{}; !fs::stat(vp_name, s) || s.size != vp.data.size() * sizeof(u32))
-			{
-				fs::write_file(vp_name, fs::rewrite, vp.data);
-			}
+			pipeline_data data = pack(pipeline, vp, fp);
+			const u64 key = get_pipeline_key(data);
 
-			u64 state_hash = 0;
-			state_hash ^= rpcs3::hash_base<u32>(data.vp_ctrl);
-			state_hash ^= rpcs3::hash_base<u32>(data.fp_ctrl);
-			state_hash ^= rpcs3::hash_base<u32>(data.vp_texture_dimensions);
-			state_hash ^= rpcs3::hash_base<u32>(data.fp_texture_dimensions);
-			state_hash ^= rpcs3::hash_base<u32>(data.fp_texcoord_control);
-			state_hash ^= rpcs3::hash_base<u16>(data.fp_unnormalized_coords);
-			state_hash ^= rpcs3::hash_base<u16>(data.fp_height);
-			state_hash ^= rpcs3::hash_base<u16>(data.fp_pixel_layout);
-			state_hash ^= rpcs3::hash_base<u16>(data.fp_lighting_flags);
-			state_hash ^= rpcs3::hash_base<u16>(data.fp_shadow_textures);
-			state_hash ^= rpcs3::hash_base<u16>(data.fp_redirected_textures);
+			std::vector<u8> records;
+			{
+				std::lock_guard lock(m_records_mutex);
 
-			const std::string pipeline_file_name = fmt::format("%llX+%llX+%llX+%llX.bin", data.vertex_program_hash, data.fragment_program_hash, data.pipeline_storage_hash, state_hash);
-			const std::string pipeline_path = root_path + "/pipelines/" + pipeline_class_name + "/" + version_prefix + "/" + pipeline_file_name;
-			fs::write_file(pipeline_path, fs::rewrite, &data, sizeof(data));
-		}
+				if (!m_stored_pipelines.insert(key).second)
+				{
+					return;
+				}
 
-		RSXVertexProgram load_vp_raw(u64 program_hash) const
-		{
-			RSXVertexProgram vp = {};
+				// Programs go first so that a truncated archive never holds a pipeline without its programs
+				if (m_stored_vertex_programs.insert(data.vertex_program_hash).second)
+				{
+					append_record(records, record_type::vertex_program, data.vertex_program_hash, vp.data.data(), ::size32(vp.data) * sizeof(u32));
+				}
 
-			fs::file f(fmt::format("%s/raw/%llX.vp", root_path, program_hash));
-			if (f) f.read(vp.data, f.size() / sizeof(u32));
+				if (m_stored_fragment_programs.insert(data.fragment_program_hash).second)
+				{
+					append_record(records, record_type::fragment_program, data.fragment_program_hash, fp.get_data(), fp.ucode_length);
+				}
+			}
 
-			vp.skip_vertex_input_check = true;
+			append_record(records, record_type::pipeline, key, &data, sizeof(data));
 
-			return vp;
+			// Disk I/O is left to the writer thread
+			m_pending_records.push(std::move(records));
 		}
 
-		RSXFragmentProgram load_fp_raw(u64 program_hash)
+		std::tuple<pipeline_storage_type, RSXVertexProgram, RSXFragmentProgram> unpack(pipeline_data &data, const archive_index& index)
 		{
-			fs::file f(fmt::format("%s/raw/%llX.fp", root_path, program_hash));
-
-			RSXFragmentProgram fp = {};
+			std::tuple<pipeline_storage_type, RSXVertexProgram, RSXFragmentProgram> result;
+			auto& [pipeline, vp, fp] = result;
 
-			const u32 size = fp.ucode_length = f ? ::size32(f) : 0;
+			const auto vp_blob = index.vertex_programs.find(data.vertex_program_hash);
+			const auto fp_blob = index.fragment_programs.find(data.fragment_program_hash);
 
-			if (!size)
+			if (vp_blob == index.vertex_programs.end() || fp_blob == index.fragment_programs.end())
 			{
-				return fp;
+				return result;
 			}
 
-			auto buf = std::make_unique<u8[]>(size);
-			fp.data = buf.get();
-			f.read(buf.get(), size);
-			fragment_program_data[fragment_program_data.push_begin()] = std::move(buf);
-			return fp;
-		}
+			vp.data.resize(vp_blob->second.size() / sizeof(u32));
+			std::memcpy(vp.data.data(), vp_blob->second.data(), vp.data.size() * sizeof(u32));
+			vp.skip_vertex_input_check = true;
 
-		std::tuple<pipeline_storage_type, RSXVertexProgram, RSXFragmentProgram> unpack(pipeline_data &data)
-		{
-			std::tuple<pipeline_storage_type, RSXVertexProgram, RSXFragmentProgram> result;
-			auto& [pipeline, vp, fp] = result;
+			// Point at the archive image and take a private copy, the index does not outlive the load
+			fp.data = const_cast<u8*>(fp_blob->second.data());
+			fp.ucode_length = ::size32(fp_blob->second);
+			fp.clone_data();
 
-			vp = load_vp_raw(data.vertex_program_hash);
-			fp = load_fp_raw(data.fragment_program_hash);
 			pipeline = data.pipeline_properties;
 
 			vp.output_mask = data.vp_ctrl;
@@ -437,6 +893,21 @@ namespace rsx
 
 	namespace vertex_cache
 	{
+		struct cache_statistics
+		{
+			u64 hits = 0;
+			u64 misses = 0;
+			u64 stale_data = 0;      // Guest memory changed since upload
+			u64 stale_heap = 0;      // Heap block was recycled since upload
+			u64 evictions = 0;
+
+			f64 hit_rate() const
+			{
+				const u64 lookups = hits + misses;
+				return lookups ? (static_cast<f64>(hits) / lookups) : 0.;
+			}
+		};
+
 		// A null vertex cache
 		template <typename storage_type, typename upload_format>
 		class default_vertex_cache
@@ -446,11 +917,21 @@ namespace rsx
 			virtual storage_type* find_vertex_range(uptr /*local_addr*/, upload_format, u32 /*data_length*/) { return nullptr; }
 			virtual void store_range(uptr /*local_addr*/, upload_format, u32 /*data_length*/, u32 /*offset_in_heap*/) {}
 			virtual void purge() {}
+
+			// Called at frame boundary. Caches that cannot validate their contents must drop everything here
+			virtual void on_frame_end() { purge(); }
+
+			// Drop any entries overlapping an invalidated (e.g unmapped) memory range
+			virtual void invalidate_range(const utils::address_range& /*range*/) {}
+
+			// Current allocation marker and size of the heap backing the cached ranges. Must be called before lookups.
+			virtual void update_heap_state(u64 /*heap_marker*/, u64 /*heap_size*/) {}
+
+			virtual cache_statistics get_statistics() const { return {}; }
 		};
 
 		// A weak vertex cache with no data checks or memory range locks
 		// Of limited use since contents are only guaranteed to be valid once per frame
-		// TODO: Strict vertex cache with range locks
 		template <typename upload_format>
 		struct uploaded_range
 		{
@@ -458,6 +939,11 @@ namespace rsx
 			upload_format buffer_format;
 			u32 offset_in_heap;
 			u32 data_length;
+
+			// Only used by the persistent cache
+			u64 data_hash;
+			u64 heap_marker;
+			u64 last_use;
 		};
 
 		template <typename upload_format>
@@ -500,5 +986,247 @@ namespace rsx
 				vertex_ranges.clear();
 			}
 		};
+
+		// A vertex cache that keeps uploaded ranges across frames.
+		// Entries are keyed by guest address, format and length and are validated on every hit against
+		// a hash of the guest data and the allocation marker of the heap, so a range is only reused
+		// while neither the source data nor the heap block holding the converted data has been overwritten.
+		template <typename upload_format>
+		class persistent_vertex_cache : public default_vertex_cache<uploaded_range<upload_format>, upload_format>
+		{
+			using storage_type = uploaded_range<upload_format>;
+
+		private:
+			std::unordered_map<uptr, std::vector<storage_type>> vertex_ranges;
+			usz m_entry_count = 0;
+			usz m_max_entries;
+
+			u64 m_heap_marker = 0;
+			u64 m_heap_size = 0;
+			u64 m_use_counter = 0;
+
+			// Hash of the most recent failed lookup, reused by the following store_range
+			uptr m_last_lookup_address = umax;
+			u32 m_last_lookup_length = 0;
+			u64 m_last_lookup_hash = 0;
+
+			cache_statistics m_stats;
+
+			// Invalidation requests may come from other threads (e.g unmap), they are applied on the next lookup
+			shared_mutex m_invalidation_lock;
+			std::vector<utils::address_range> m_pending_invalidations;
+			atomic_t<bool> m_invalidation_pending = false;
+
+			void process_invalidations()
+			{
+				std::vector<utils::address_range> pending;
+				{
+					std::lock_guard lock(m_invalidation_lock);
+					pending = std::move(m_pending_invalidations);
+					m_pending_invalidations.clear();
+					m_invalidation_pending = false;
+				}
+
+				for (auto it = vertex_ranges.begin(); it != vertex_ranges.end();)
+				{
+					auto& ranges = it->second;
+					const auto old_size = ranges.size();
+
+					ranges.erase(std::remove_if(ranges.begin(), ranges.end(), [&](const storage_type& v)
+					{
+						const auto block = utils::address_range::start_length(static_cast<u32>(v.local_address), v.data_length);
+						return std::any_of(pending.begin(), pending.end(), [&](const auto& range) { return range.overlaps(block); });
+					}), ranges.end());
+
+					m_entry_count -= (old_size - ranges.size());
+
+					if (ranges.empty())
+					{
+						it = vertex_ranges.erase(it);
+					}
+					else
+					{
+						++it;
+					}
+				}
+
+				m_last_lookup_address = umax;
+			}
+
+			u64 hash_range(uptr local_addr, u32 data_length)
+			{
+				if (local_addr == m_last_lookup_address && data_length == m_last_lookup_length)
+				{
+					return m_last_lookup_hash;
+				}
+
+				m_last_lookup_address = local_addr;
+				m_last_lookup_length = data_length;
+				m_last_lookup_hash = rsx::hash_guest_memory(static_cast<u32>(local_addr), data_length);
+				return m_last_lookup_hash;
+			}
+
+			bool is_heap_block_valid(const storage_type& v) const
+			{
+				// The entry was allocated after heap_marker. It is intact until the heap has advanced by a full cycle since then.
+				return (m_heap_marker - v.heap_marker) <= m_heap_size;
+			}
+
+			void evict_lru()
+			{
+				// Remove the least recently used quarter of the entries in one sweep to amortize the cost
+				std::vector<u64> ages;
+				ages.reserve(m_entry_count);
+
+				for (const auto& [addr, ranges] : vertex_ranges)
+				{
+					for (const auto& v : ranges)
+					{
+						ages.push_back(v.last_use);
+					}
+				}
+
+				auto cutoff_it = ages.begin() + (ages.size() / 4);
+				std::nth_element(ages.begin(), cutoff_it, ages.end());
+				const u64 cutoff = *cutoff_it;
+
+				for (auto it = vertex_ranges.begin(); it != vertex_ranges.end();)
+				{
+					auto& ranges = it->second;
+					const auto old_size = ranges.size();
+
+					ranges.erase(std::remove_if(ranges.begin(), ranges.end(), [&](const storage_type& v)
+					{
+						return v.last_use <= cutoff || !is_heap_block_valid(v);
+					}), ranges.end());
+
+					m_stats.evictions += (old_size - ranges.size());
+					m_entry_count -= (old_size - ranges.size());
+
+					if (ranges.empty())
+					{
+						it = vertex_ranges.erase(it);
+					}
+					else
+					{
+						++it;
+					}
+				}
+			}
+
+		public:
+
+			persistent_vertex_cache(usz max_entries = 16384)
+				: m_max_entries(max_entries)
+			{}
+
+			~persistent_vertex_cache()
+			{
+				if (const u64 lookups = m_stats.hits + m_stats.misses)
+				{
+					rsx_log.notice("Vertex cache: %llu lookups, hit rate %.2f%% (stale data=%llu, recycled heap=%llu, evicted=%llu)",
+						lookups, m_stats.hit_rate() * 100., m_stats.stale_data, m_stats.stale_heap, m_stats.evictions);
+				}
+			}
+
+			storage_type* find_vertex_range(uptr local_addr, upload_format fmt, u32 data_length) override
+			{
+				if (m_invalidation_pending) [[unlikely]]
+				{
+					process_invalidations();
+				}
+
+				m_last_lookup_address = umax;
+
+				auto found = vertex_ranges.find(local_addr);
+				if (found == vertex_ranges.end())
+				{
+					m_stats.misses++;
+					return nullptr;
+				}
+
+				auto& ranges = found->second;
+				for (auto it = ranges.begin(); it != ranges.end(); ++it)
+				{
+					if (it->buffer_format != fmt || it->data_length != data_length)
+					{
+						continue;
+					}
+
+					if (!is_heap_block_valid(*it))
+					{
+						m_stats.stale_heap++;
+					}
+					else if (it->data_hash != hash_range(local_addr, data_length))
+					{
+						m_stats.stale_data++;
+					}
+					else
+					{
+						it->last_use = ++m_use_counter;
+						m_stats.hits++;
+						return &(*it);
+					}
+
+					// Entry is dead, a new one will be stored by the caller
+					ranges.erase(it);
+					m_entry_count--;
+					break;
+				}
+
+				m_stats.misses++;
+				return nullptr;
+			}
+
+			void store_range(uptr local_addr, upload_format fmt, u32 data_length, u32 offset_in_heap) override
+			{
+				if (m_entry_count >= m_max_entries)
+				{
+					evict_lru();
+				}
+
+				storage_type v = {};
+				v.buffer_format = fmt;
+				v.data_length = data_length;
+				v.local_address = local_addr;
+				v.offset_in_heap = offset_in_heap;
+				v.data_hash = hash_range(local_addr, data_length);
+				v.heap_marker = m_heap_marker;
+				v.last_use = ++m_use_counter;
+
+				vertex_ranges[local_addr].push_back(v);
+				m_entry_count++;
+			}
+
+			void purge() override
+			{
+				vertex_ranges.clear();
+				m_entry_count = 0;
+				m_last_lookup_address = umax;
+			}
+
+			void on_frame_end() override
+			{
+				// Contents are validated on lookup, nothing to do
+			}
+
+			void invalidate_range(const utils::address_range& range) override
+			{
+				std::lock_guard lock(m_invalidation_lock);
+				m_pending_invalidations.push_back(range);
+				m_invalidation_pending = true;
+			}
+
+			void update_heap_state(u64 heap_marker, u64 heap_size) override
+			{
+				m_heap_marker = heap_marker;
+				m_heap_size = heap_size;
+			}
+
+			cache_statistics get_statistics() const override
+			{
+				return m_stats;
+			}
+		};
 	}
 }
@@ -5,6 +5,7 @@
 #include "rsx_decode.h"
 #include "Emu/Cell/PPUCallback.h"
 #include "Emu/Cell/lv2/sys_rsx.h"
+#include "Emu/RSX/Common/BlitUtils.h"
 #include "Emu/RSX/Common/BufferUtils.h"
 
 #include <thread>
@@ -1292,8 +1293,8 @@ namespace rsx
 				in_pitch = packed_pitch;
 			}
 
-			const AVPixelFormat in_format = (src_color_format == rsx::blit_engine::transfer_source_format::r5g6b5) ? AV_PIX_FMT_RGB565BE : AV_PIX_FMT_ARGB;
-			const AVPixelFormat out_format = (dst_color_format == rsx::blit_engine::transfer_destination_format::r5g6b5) ? AV_PIX_FMT_RGB565BE : AV_PIX_FMT_ARGB;
+			const blit_pixel_format in_format = (src_color_format == rsx::blit_engine::transfer_source_format::r5g6b5) ? blit_pixel_format::r5g6b5 : blit_pixel_format::a8r8g8b8;
+			const blit_pixel_format out_format = (dst_color_format == rsx::blit_engine::transfer_destination_format::r5g6b5) ? blit_pixel_format::r5g6b5 : blit_pixel_format::a8r8g8b8;
 
 			const bool need_clip =
 				clip_w != in_w ||
@@ -1303,6 +1304,8 @@ namespace rsx
 
 			const bool need_convert = out_format != in_format || !rsx::fcmp(fabsf(scale_x), 1.f) || !rsx::fcmp(fabsf(scale_y), 1.f);
 			const u32 slice_h = static_cast<u32>(std::ceil(static_cast<f32>(clip_h + clip_y) / scale_y));
+			const bool bilinear = in_inter == blit_engine::transfer_interpolator::foh;
+			const blit_image_desc src_image = { pixels_src, in_format, in_w, in_h, in_pitch };
 
 			if (method_registers.blit_engine_context_surface() != blit_engine::context_surface::swizzle2d)
 			{
@@ -1378,19 +1381,38 @@ namespace rsx
 				}
 				else
 				{
-					if (need_clip)
+					// Only the clipped region of the scaled image is produced
+					const blit_target_desc target = need_clip ?
+						blit_target_desc{ pixels_dst, out_format, out_pitch, convert_w, convert_h, clip_x, clip_y, clip_w, clip_h } :
+						blit_target_desc{ pixels_dst, out_format, out_pitch, out_w, out_h, 0, 0, out_w, out_h };
+
+					const u32 dst_rows = need_clip ? clip_h : out_h;
+					const u32 dst_length = out_pitch * (dst_rows - 1) + out_bpp * (need_clip ? clip_w : out_w);
+
+					const bool is_overlapping = scale_x > 0 && scale_y > 0 && dst_dma == src_dma && [&]() -> bool
 					{
-						temp2.resize(out_pitch * std::max<u32>(convert_h, clip_h));
+						const u32 src_max = src_offset + in_pitch * (in_h - 1) + (in_bpp * in_w);
+						const u32 dst_max = dst_offset + dst_length;
+						return (src_offset >= dst_offset && src_offset < dst_max) ||
+						 (dst_offset >= src_offset && dst_offset < src_max);
+					}();
+
+					if (is_overlapping)
+					{
+						// The source rows are still being read while the destination is written, stage the result.
+						// The destination block is copied in first so that bytes outside the written region are preserved
+						temp2.resize(dst_length);
+						std::memcpy(temp2.data(), pixels_dst, dst_length);
 
-						convert_scale_image(temp2.data(), out_format, convert_w, convert_h, out_pitch,
-							pixels_src, in_format, in_w, in_h, in_pitch, slice_h, in_inter == blit_engine::transfer_interpolator::foh);
+						blit_target_desc staged = target;
+						staged.pixels = temp2.data();
+						convert_scale_image(staged, src_image, slice_h, bilinear);
 
-						clip_image(pixels_dst, temp2.data(), clip_x, clip_y, clip_w, clip_h, out_bpp, out_pitch, out_pitch);
+						std::memcpy(pixels_dst, temp2.data(), dst_length);
 					}
 					else
 					{
-						convert_scale_image(pixels_dst, out_format, out_w, out_h, out_pitch,
-							pixels_src, in_format, in_w, in_h, in_pitch, slice_h, in_inter == blit_engine::transfer_interpolator::foh);
+						convert_scale_image(target, src_image, slice_h, bilinear);
 					}
 				}
 			}
@@ -1404,12 +1426,7 @@ namespace rsx
 
 						if (need_convert)
 						{
-							temp2.resize(out_pitch * std::max<u32>(convert_h, clip_h));
-
-							convert_scale_image(temp2.data(), out_format, convert_w, convert_h, out_pitch,
-								pixels_src, in_format, in_w, in_h, in_pitch, slice_h, in_inter == blit_engine::transfer_interpolator::foh);
-
-							clip_image(temp3.data(), temp2.data(), clip_x, clip_y, clip_w, clip_h, out_bpp, out_pitch, out_pitch);
+							convert_scale_image({ temp3.data(), out_format, out_pitch, convert_w, convert_h, clip_x, clip_y, clip_w, clip_h }, src_image, slice_h, bilinear);
 						}
 						else
 						{
@@ -1420,8 +1437,7 @@ namespace rsx
 					{
 						temp3.resize(out_pitch * out_h);
 
-						convert_scale_image(temp3.data(), out_format, out_w, out_h, out_pitch,
-							pixels_src, in_format, in_w, in_h, in_pitch, slice_h, in_inter == blit_engine::transfer_interpolator::foh);
+						convert_scale_image({ temp3.data(), out_format, out_pitch, out_w, out_h, 0, 0, out_w, out_h }, src_image, slice_h, bilinear);
 					}
 
 					pixels_src = temp3.data();
@@ -4,40 +4,15 @@
 #include "Emu/RSX/GCM.h"
 #include "Overlays/overlays.h"
 
-#ifdef _MSC_VER
-#pragma warning(push, 0)
-#else
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wall"
-#pragma GCC diagnostic ignored "-Wextra"
-#pragma GCC diagnostic ignored "-Wold-style-cast"
-#pragma GCC diagnostic ignored "-Wstrict-aliasing"
-#endif
-extern "C"
-{
-#include "libswscale/swscale.h"
-}
-#ifdef _MSC_VER
-#pragma warning(pop)
-#else
-#pragma GCC diagnostic pop
-#endif
-
 #include "util/sysinfo.hpp"
+#include "Emu/Memory/vm.h"
+
+#include "xxhash.h"
 
 namespace rsx
 {
 	atomic_t<u64> g_rsx_shared_tag{ 0 };
 
-	void convert_scale_image(u8 *dst, AVPixelFormat dst_format, int dst_width, int dst_height, int dst_pitch,
-		const u8 *src, AVPixelFormat src_format, int src_width, int src_height, int src_pitch, int src_slice_h, bool bilinear)
-	{
-		std::unique_ptr<SwsContext, void(*)(SwsContext*)> sws(sws_getContext(src_width, src_height, src_format,
-			dst_width, dst_height, dst_format, bilinear ? SWS_FAST_BILINEAR : SWS_POINT, nullptr, nullptr, nullptr), sws_freeContext);
-
-		sws_scale(sws.get(), &src, &src_pitch, 0, src_slice_h, &dst, &dst_pitch);
-	}
-
 	void clip_image(u8 *dst, const u8 *src, int clip_x, int clip_y, int clip_w, int clip_h, int bpp, int src_pitch, int dst_pitch)
 	{
 		const u8* pixels_src = src + clip_y * src_pitch + clip_x * bpp;
@@ -78,6 +53,11 @@ namespace rsx
 		}
 	}
 
+	u64 hash_guest_memory(u32 address, u32 length)
+	{
+		return XXH64(vm::base(address), length, 0);
+	}
+
 	//Convert decoded integer values for CONSTANT_BLEND_FACTOR into f32 array in 0-1 range
 	std::array<float, 4> get_constant_blend_colors()
 	{
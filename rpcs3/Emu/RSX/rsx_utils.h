@@ -9,11 +9,6 @@
 #include <bitset>
 #include <chrono>
 
-extern "C"
-{
-#include <libavutil/pixfmt.h>
-}
-
 #define RSX_SURFACE_DIMENSION_IGNORED 1
 
 namespace rsx
@@ -339,11 +334,12 @@ namespace rsx
 	/*   Note: What the ps3 calls swizzling in this case is actually z-ordering / morton ordering of pixels
 	*       - Input can be swizzled or linear, bool flag handles conversion to and from
 	*       - It will handle any width and height that are a power of 2, square or non square
+	*       - Rows [first_row, last_row) can be converted independently, allowing the work to be split across threads
 	*    Restriction: It has mixed results if the height or width is not a power of 2
 	*    Restriction: Only works with 2D surfaces
 	*/
 	template <typename T, bool input_is_swizzled>
-	void convert_linear_swizzle(const void* input_pixels, void* output_pixels, u16 width, u16 height, u32 pitch)
+	void convert_linear_swizzle(const void* input_pixels, void* output_pixels, u16 width, u16 height, u32 pitch, u16 first_row = 0, u16 last_row = umax)
 	{
 		u32 log2width = ceil_log2(width);
 		u32 log2height = ceil_log2(height);
@@ -353,25 +349,33 @@ namespace rsx
 		u32 y_mask = 0xAAAAAAAA;
 
 		// We have to limit the masks to the lower of the two dimensions to allow for non-square textures
-		u32 limit_mask = (log2width < log2height) ? log2width : log2height;
+		const u32 limit_bits = (log2width < log2height) ? log2width : log2height;
 		// double the limit mask to account for bits in both x and y
-		limit_mask = 1 << (limit_mask << 1);
+		const u32 limit_mask = 1 << (limit_bits << 1);
 
 		//x_mask, bits above limit are 1's for x-carry
 		x_mask = (x_mask | ~(limit_mask - 1));
 		//y_mask. bits above limit are 0'd, as we use a different method for y-carry over
 		y_mask = (y_mask & (limit_mask - 1));
 
+		const u32 y_incr = limit_mask;
+		last_row = std::min(last_row, height);
+
+		// Reconstruct the carry state at the first row. Bits of y below the limit live in the odd bits, the rest is a linear carry.
 		u32 offs_y = 0;
 		u32 offs_x = 0;
-		u32 offs_x0 = 0; //total y-carry offset for x
-		u32 y_incr = limit_mask;
+		u32 offs_x0 = (first_row >> limit_bits) * y_incr; //total y-carry offset for x
+
+		for (u32 bit = 0; bit < limit_bits; ++bit)
+		{
+			offs_y |= ((first_row >> bit) & 1u) << (bit * 2 + 1);
+		}
 
 		u32 adv = pitch / sizeof(T);
 
 		if constexpr (!input_is_swizzled)
 		{
-			for (int y = 0; y < height; ++y)
+			for (int y = first_row; y < last_row; ++y)
 			{
 				auto src = static_cast<const T*>(input_pixels) + y * adv;
 				auto dst = static_cast<T*>(output_pixels) + offs_y;
@@ -393,7 +397,38 @@ namespace rsx
 		}
 		else
 		{
-			for (int y = 0; y < height; ++y)
+			int y = first_row;
+
+			if (limit_bits && !(width & 1) && !(first_row & 1))
+			{
+				// Every run of 4 swizzled texels is a 2x2 quad. Copy two texels into each of two rows at a time.
+				const u32 x_mask2 = x_mask & ~1u;
+				const u32 y_mask2 = y_mask & ~2u;
+
+				for (; (y + 1) < last_row; y += 2)
+				{
+					auto src = static_cast<const T*>(input_pixels) + offs_y;
+					auto dst0 = static_cast<T*>(output_pixels) + y * adv;
+					auto dst1 = dst0 + adv;
+					offs_x = offs_x0;
+
+					for (int x = 0; x < width; x += 2)
+					{
+						std::memcpy(dst0 + x, src + offs_x, sizeof(T) * 2);
+						std::memcpy(dst1 + x, src + offs_x + 2, sizeof(T) * 2);
+						offs_x = (offs_x - x_mask2) & x_mask2;
+					}
+
+					offs_y = (offs_y - y_mask2) & y_mask2;
+
+					if (offs_y == 0)
+					{
+						offs_x0 += y_incr;
+					}
+				}
+			}
+
+			for (; y < last_row; ++y)
 			{
 				auto src = static_cast<const T*>(input_pixels) + offs_y;
 				auto dst = static_cast<T*>(output_pixels) + y * adv;
@@ -420,9 +455,10 @@ namespace rsx
 	 * Z ordering is done in all 3 planes independently with a unit being a 2x2 block per-plane
 	 * A unit in 3d textures is a group of 2x2x2 texels advancing towards depth in units of 2x2x1 blocks
 	 * i.e 32 texels per "unit"
+	 * Slices [first_slice, last_slice) are independent and can be converted separately.
 	 */
 	template <typename T>
-	void convert_linear_swizzle_3d(const void* input_pixels, void* output_pixels, u16 width, u16 height, u16 depth)
+	void convert_linear_swizzle_3d(const void* input_pixels, void* output_pixels, u16 width, u16 height, u16 depth, u16 first_slice = 0, u16 last_slice = umax)
 	{
 		if (depth == 1)
 		{
@@ -431,13 +467,15 @@ namespace rsx
 		}
 
 		auto src = static_cast<const T*>(input_pixels);
-		auto dst = static_cast<T*>(output_pixels);
+		auto dst = static_cast<T*>(output_pixels) + u32{first_slice} * width * height;
 
 		const u32 log2_w = ceil_log2(width);
 		const u32 log2_h = ceil_log2(height);
 		const u32 log2_d = ceil_log2(depth);
 
-		for (u32 z = 0; z < depth; ++z)
+		last_slice = std::min(last_slice, depth);
+
+		for (u32 z = first_slice; z < last_slice; ++z)
 		{
 			for (u32 y = 0; y < height; ++y)
 			{
@@ -449,14 +487,14 @@ namespace rsx
 		}
 	}
 
-	void convert_scale_image(u8 *dst, AVPixelFormat dst_format, int dst_width, int dst_height, int dst_pitch,
-		const u8 *src, AVPixelFormat src_format, int src_width, int src_height, int src_pitch, int src_slice_h, bool bilinear);
-
 	void clip_image(u8 *dst, const u8 *src, int clip_x, int clip_y, int clip_w, int clip_h, int bpp, int src_pitch, int dst_pitch);
 	void clip_image_may_overlap(u8 *dst, const u8 *src, int clip_x, int clip_y, int clip_w, int clip_h, int bpp, int src_pitch, int dst_pitch, u8* buffer);
 
 	std::array<float, 4> get_constant_blend_colors();
 
+	// Fast non-cryptographic hash of a block of guest memory
+	u64 hash_guest_memory(u32 address, u32 length);
+
 	/**
 	 * Shuffle texel layout from xyzw to wzyx
 	 * TODO: Variable src/dst and optional se conversion
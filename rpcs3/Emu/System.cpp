@@ -372,20 +372,16 @@ std::string Emulator::GetBackgroundPicturePath() const
 
 bool Emulator::BootRsxCapture(const std::string& path)
 {
-	fs::file in_file(path);
+	std::unique_ptr<rsx::frame_capture_data> frame = std::make_unique<rsx::frame_capture_data>();
+	std::unique_ptr<rsx::frame_capture_reader> reader = std::make_unique<rsx::frame_capture_reader>();
 
-	if (!in_file)
+	// Only the header is read here, frames are streamed from the file during replay
+	if (!reader->open(path, *frame))
 	{
+		sys_log.error("Invalid rsx capture file!");
 		return false;
 	}
 
-	std::unique_ptr<rsx::frame_capture_data> frame = std::make_unique<rsx::frame_capture_data>();
-	utils::serial load_manager;
-	load_manager.set_reading_state(in_file.to_vector<u8>());
-
-	load_manager(*frame);
-	in_file.close();
-
 	if (frame->magic != rsx::c_fc_magic)
 	{
 		sys_log.error("Invalid rsx capture file!");
@@ -411,6 +407,13 @@ bool Emulator::BootRsxCapture(const std::string& path)
 	Init();
 	g_cfg.video.disable_on_disk_shader_cache.set(true);
 
+	if (g_cfg.video.capture_benchmark.enabled)
+	{
+		// Frames are replayed back to back, pacing would only add noise to the measurements
+		g_cfg.video.frame_limit.set(frame_limit_type::none);
+		g_cfg.video.frame_skip_enabled.set(false);
+	}
+
 	vm::init();
 	g_fxo->init(false);
 
@@ -424,7 +427,7 @@ bool Emulator::BootRsxCapture(const std::string& path)
 	GetCallbacks().on_run(false);
 	m_state = system_state::running;
 
-	auto replay_thr = g_fxo->init<named_thread<rsx::rsx_replay_thread>>("RSX Replay", std::move(frame));
+	auto replay_thr = g_fxo->init<named_thread<rsx::rsx_replay_thread>>("RSX Replay", std::move(frame), std::move(reader));
 	replay_thr->state -= cpu_flag::stop;
 	replay_thr->state.notify_one(cpu_flag::stop);
 
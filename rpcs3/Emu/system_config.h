@@ -150,11 +150,14 @@ struct cfg_root : cfg::node
 		cfg::_bool disable_vulkan_mem_allocator{ this, "Disable Vulkan Memory Allocator", false };
 		cfg::_bool full_rgb_range_output{ this, "Use full RGB output range", true, true }; // Video out dynamic range
 		cfg::_bool strict_texture_flushing{ this, "Strict Texture Flushing", false };
+		cfg::_bool texture_content_hashing{ this, "Texture Content Hashing", false };
 		cfg::_bool disable_native_float16{ this, "Disable native float16 support", false };
 		cfg::_bool multithreaded_rsx{ this, "Multithreaded RSX", false };
 		cfg::_bool relaxed_zcull_sync{ this, "Relaxed ZCULL Sync", false };
+		cfg::_bool speculative_zcull_reports{ this, "Speculative ZCULL Reports", false };
 		cfg::_bool enable_3d{ this, "Enable 3D", false };
 		cfg::_bool debug_program_analyser{ this, "Debug Program Analyser", false };
+		cfg::_bool null_renderer_full_pipeline{ this, "Null Renderer Full Pipeline", false }; // Run draws through the RSX front-end on host memory with the Null renderer
 		cfg::_int<1, 8> consecutive_frames_to_draw{ this, "Consecutive Frames To Draw", 1, true};
 		cfg::_int<1, 8> consecutive_frames_to_skip{ this, "Consecutive Frames To Skip", 1, true};
 		cfg::_int<50, 800> resolution_scale_percent{ this, "Resolution Scale", 100 };
@@ -162,9 +165,12 @@ struct cfg_root : cfg::node
 		cfg::_int<-16, 16> texture_lod_bias{ this, "Texture LOD Bias Addend", 0, true };
 		cfg::_int<1, 1024> min_scalable_dimension{ this, "Minimum Scalable Dimension", 16 };
 		cfg::_int<0, 16> shader_compiler_threads_count{ this, "Shader Compiler Threads", 0 };
+		cfg::_int<0, 16> texture_decoder_threads_count{ this, "Texture Decoder Threads", 0 }; // 0 = auto, 1 = decode on the RSX thread only
+		cfg::_int<0, 65536> texture_cache_memory_budget{ this, "Texture Cache Memory Budget", 0 }; // In MiB, 0 = unlimited
 		cfg::_int<0, 30000000> driver_recovery_timeout{ this, "Driver Recovery Timeout", 1000000, true };
 		cfg::_int<0, 16667> driver_wakeup_delay{ this, "Driver Wake-Up Delay", 1, true };
 		cfg::_int<1, 1800> vblank_rate{ this, "Vblank Rate", 60, true }; // Changing this from 60 may affect game speed in unexpected ways
+		cfg::_int<1, 3600> capture_frame_count{ this, "RSX Capture Frame Count", 1, true }; // Consecutive frames recorded by a single RSX capture
 		cfg::_bool decr_memory_layout{ this, "DECR memory layout", false}; // Force enable increased allowed main memory range as DECR console
 
 		struct node_vk : cfg::node
@@ -177,6 +183,7 @@ struct cfg_root : cfg::node
 			cfg::_bool force_disable_exclusive_fullscreen_mode{this, "Force Disable Exclusive Fullscreen Mode"};
 			cfg::_bool asynchronous_texture_streaming{ this, "Asynchronous Texture Streaming 2", false };
 			cfg::_enum<vk_gpu_scheduler_mode> asynchronous_scheduler{ this, "Asynchronous Queue Scheduler", vk_gpu_scheduler_mode::device };
+			cfg::_bool use_rebar_heaps{ this, "Use Resizable BAR for Streaming Heaps", true };
 
 		} vk{ this };
 
@@ -205,6 +212,7 @@ struct cfg_root : cfg::node
 			cfg::string background_body{ this, "Body Background (hex)", "#002339FF", true };
 			cfg::string color_title{ this, "Title Color (hex)", "#F26C24FF", true };
 			cfg::string background_title{ this, "Title Background (hex)", "#00000000", true };
+			cfg::_bool frame_stats_csv{ this, "Export Frame Statistics (CSV)", false, true };
 
 		} perf_overlay{ this };
 
@@ -227,6 +235,16 @@ struct cfg_root : cfg::node
 
 		} shader_preloading_dialog{ this };
 
+		struct node_capture_benchmark : cfg::node
+		{
+			node_capture_benchmark(cfg::node* _this) : cfg::node(_this, "RSX Capture Benchmark") {}
+
+			cfg::_bool enabled{ this, "Enabled", false }; // Replays RSX captures as a benchmark and writes a JSON report
+			cfg::uint<0, 100> warmup_iterations{ this, "Warmup Iterations", 2 };
+			cfg::uint<1, 10000> iterations{ this, "Iterations", 10 };
+
+		} capture_benchmark{ this };
+
 	} video{ this };
 
 	struct node_audio : cfg::node
@@ -866,6 +866,22 @@ int main(int argc, char** argv)
 			Emu.argv = std::move(rpcs3_argv);
 			Emu.SetForceBoot(true);
 
+			if (path.ends_with(".rrc"))
+			{
+				// RSX capture, allows running the capture replay benchmark without the GUI
+				if (!Emu.BootRsxCapture(path))
+				{
+					sys_log.error("Booting RSX capture '%s' with cli argument failed", path);
+
+					if (s_headless || s_no_gui)
+					{
+						report_fatal_error(fmt::format("Booting RSX capture '%s' failed!", path));
+					}
+				}
+
+				return;
+			}
+
 			if (const game_boot_result error = Emu.BootGame(path, ""); error != game_boot_result::no_errors)
 			{
 				sys_log.error("Booting '%s' with cli argument failed: reason: %s", path, error);
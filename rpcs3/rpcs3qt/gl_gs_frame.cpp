@@ -79,6 +79,16 @@ void gl_gs_frame::set_current(draw_context_t ctx)
 	}
 }
 
+void gl_gs_frame::release_current(draw_context_t ctx)
+{
+	if (!ctx)
+	{
+		fmt::throw_exception("Null context handle passed to release_current");
+	}
+
+	static_cast<GLContext*>(ctx)->handle->doneCurrent();
+}
+
 void gl_gs_frame::delete_context(draw_context_t ctx)
 {
 	const auto gl_ctx = static_cast<GLContext*>(ctx);
@@ -22,6 +22,7 @@ public:
 
 	draw_context_t make_context() override;
 	void set_current(draw_context_t ctx) override;
+	void release_current(draw_context_t ctx) override;
 	void delete_context(draw_context_t ctx) override;
 	void flip(draw_context_t context, bool skip_frame = false) override;
 };
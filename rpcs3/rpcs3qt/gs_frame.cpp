@@ -377,6 +377,11 @@ void gs_frame::set_current(draw_context_t context)
 	Q_UNUSED(context)
 }
 
+void gs_frame::release_current(draw_context_t context)
+{
+	Q_UNUSED(context)
+}
+
 void gs_frame::delete_context(draw_context_t context)
 {
 	Q_UNUSED(context)
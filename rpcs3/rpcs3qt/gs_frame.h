@@ -55,6 +55,7 @@ public:
 
 	draw_context_t make_context() override;
 	void set_current(draw_context_t context) override;
+	void release_current(draw_context_t context) override;
 	void delete_context(draw_context_t context) override;
 	void toggle_fullscreen() override;
 